@@ -0,0 +1,196 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Benchmark.cpp
+*
+* Description:	Times the CPU side hot paths of the renderer: the sort key radix sort, the
+*				rectangle and circle expanders, the stroker and the ear clipper.
+*				Build with OPENGLFW_BUILD_BENCHMARKS in a Release profile and run it without
+*				arguments, the result is the time per call and per item.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "SortKey.h"
+#include "Stroke.h"
+#include "Triangulate.h"
+#include "VertexExpand.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// written by every benchmark so the optimizer keeps the work
+static unsigned long long s_sink = 0;
+
+/**
+* Runs a benchmark once to warm the caches, then for at least 0.2 seconds, and prints the time per call
+* @param name - printed in the first column
+* @param items - items handled by one call, for the time per item
+* @param run - the benchmark, one call
+*/
+template <typename Run>
+static void measure(const char* name, int items, Run run) {
+	typedef std::chrono::steady_clock Clock;
+	run();
+
+	int calls = 0;
+	Clock::time_point start = Clock::now();
+	Clock::duration elapsed;
+	do {
+		run();
+		++calls;
+		elapsed = Clock::now() - start;
+	} while (elapsed < std::chrono::milliseconds(200));
+
+	double perCall = std::chrono::duration<double, std::micro>(elapsed).count() / calls;
+	std::printf("%-28s %10.2f us/call %10.2f ns/item\n", name, perCall, perCall * 1000.0 / items);
+}
+
+/**
+* Next pseudo random value in [0, range), from a fixed seed every run times the same input
+* @param seed - state of the generator, advanced by the call
+*/
+static unsigned int next(unsigned int& seed, unsigned int range) {
+	seed = seed * 1664525u + 1013904223u;
+	return (seed >> 8) % range;
+}
+
+static void benchSortKey() {
+	const int count = 65536;
+	std::vector<unsigned long long> source(count), keys(count), tmpKeys(count);
+	std::vector<unsigned int> values(count), tmpValues(count);
+	unsigned int seed = 1;
+	for (int i = 0; i < count; ++i) {
+		// a frame mixing opaque and translucent primitives of a few pipelines and textures
+		source[i] = SortKey::make(next(seed, 4), next(seed, 64), (int)next(seed, 3), (int)next(seed, 8),
+			next(seed, 1u << 20), (unsigned long long)i);
+	}
+
+	measure("SortKey::radixSort", count, [&]() {
+		keys = source;
+		for (int i = 0; i < count; ++i) {
+			values[i] = (unsigned int)i;
+		}
+		SortKey::radixSort(keys.data(), values.data(), tmpKeys.data(), tmpValues.data(), count);
+		s_sink += keys[count / 2] + values[0];
+	});
+}
+
+static void benchVertexExpand() {
+	const int count = 16384;
+	std::vector<Renderer2D::Rect> rects(count);
+	std::vector<Renderer2D::Circle> circles(count);
+	std::vector<float> x(count), y(count), size(count), colors(count * 4);
+	unsigned int seed = 2;
+	for (int i = 0; i < count; ++i) {
+		x[i] = (float)next(seed, 2000);
+		y[i] = (float)next(seed, 2000);
+		size[i] = 1.0f + next(seed, 20);
+		for (int c = 0; c < 4; ++c) {
+			colors[i * 4 + c] = next(seed, 256) / 255.0f;
+		}
+
+		Renderer2D::Rect& rect = rects[i];
+		rect.x = x[i];
+		rect.y = y[i];
+		rect.width = rect.height = size[i];
+		Renderer2D::Circle& circle = circles[i];
+		circle.x = x[i];
+		circle.y = y[i];
+		circle.radius = size[i];
+		for (int c = 0; c < 4; ++c) {
+			rect.color[c] = circle.color[c] = colors[i * 4 + c];
+		}
+	}
+
+	// a view over a quarter of the shapes, the rest is culled
+	const float bounds[] = { 0.0f, 0.0f, 1000.0f, 1000.0f };
+	std::vector<Renderer2D::Vertex> vertices(count * VertexExpand::CIRCLE_VERTICES);
+
+	measure("VertexExpand::rects", count, [&]() {
+		s_sink += VertexExpand::rects(vertices.data(), rects.data(), 0.5f, count, nullptr);
+	});
+	measure("VertexExpand::rects soa", count, [&]() {
+		s_sink += VertexExpand::rects(vertices.data(), x.data(), y.data(), size.data(), size.data(), colors.data(), 4, 0.5f, count, nullptr);
+	});
+	measure("VertexExpand::rects culled", count, [&]() {
+		s_sink += VertexExpand::rects(vertices.data(), rects.data(), 0.5f, count, bounds);
+	});
+	measure("VertexExpand::circles", count, [&]() {
+		s_sink += VertexExpand::circles(vertices.data(), circles.data(), 0.5f, count, nullptr);
+	});
+	measure("VertexExpand::circles soa", count, [&]() {
+		s_sink += VertexExpand::circles(vertices.data(), x.data(), y.data(), size.data(), colors.data(), 4, 0.5f, count, nullptr);
+	});
+}
+
+static void benchStroke() {
+	const int count = 4096;
+	std::vector<float> points(count * 2);
+	for (int i = 0; i < count; ++i) {
+		// a wave, every point bends the line so every point gets a join
+		points[i * 2] = i * 4.0f;
+		points[i * 2 + 1] = 50.0f * std::sin(i * 0.3f);
+	}
+	std::vector<Renderer2D::Vertex> vertices(Stroke::maxVertices(count));
+	std::vector<unsigned int> indices(Stroke::maxIndices(count));
+	const float color[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	const struct {
+		const char* name;
+		Stroke::Style style;
+	} cases[] = {
+		{ "Stroke::polyline miter", { 4.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_BUTT, 1.0f } },
+		{ "Stroke::polyline round", { 4.0f, Renderer2D::JOIN_ROUND, Renderer2D::CAP_ROUND, 1.0f } },
+		{ "Stroke::polyline thin", { 1.0f, Renderer2D::JOIN_ROUND, Renderer2D::CAP_ROUND, 1.0f } }
+	};
+	for (const auto& c : cases) {
+		measure(c.name, count, [&]() {
+			int vertexCount = 0;
+			int indexCount = 0;
+			Stroke::polyline(vertices.data(), indices.data(), 0, points.data(), count, false, c.style, 0.5f, color,
+				vertexCount, indexCount);
+			s_sink += vertexCount + indexCount;
+		});
+	}
+}
+
+static void benchTriangulate() {
+	// a star outline with a square hole, every other vertex is a reflex vertex
+	const int tips = 256;
+	std::vector<float> points;
+	for (int i = 0; i < tips * 2; ++i) {
+		float angle = i * 3.14159265f / tips;
+		float radius = (i % 2 == 0) ? 100.0f : 60.0f;
+		points.push_back(radius * std::cos(angle));
+		points.push_back(radius * std::sin(angle));
+	}
+	const float hole[] = { -10.0f, -10.0f, 10.0f, -10.0f, 10.0f, 10.0f, -10.0f, 10.0f };
+	points.insert(points.end(), hole, hole + 8);
+	const int rings[] = { tips * 2, 4 };
+	std::vector<unsigned int> indices;
+
+	measure("Triangulate::earClip", tips * 2 + 4, [&]() {
+		indices.clear();
+		Triangulate::earClip(points.data(), rings, 2, indices);
+		s_sink += indices.size();
+	});
+}
+
+int main() {
+	benchSortKey();
+	benchVertexExpand();
+	benchStroke();
+	benchTriangulate();
+
+	// printed so the work cannot be optimized away
+	std::printf("checksum %llu\n", s_sink);
+	return 0;
+}
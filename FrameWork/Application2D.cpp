@@ -6,7 +6,7 @@
 * File: Application2D.cpp
 *
 * Description:	Create an OpenGL window and render the sprites drawn on the screen.
-*				The scripts for the game should be added in this class.
+*				The scripts for the game should be added in a class derived from this one.
 *
 * Author: Ramkumar Thiyagarajan
 *
@@ -15,12 +15,13 @@
 */
 
 #include "Application2D.h"
+#include "GLProfiler.h"
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 #include <iostream>
 
 /* GLFW - Initialize */
-Application2D::Application2D() : m_gameOver(false), m_window(nullptr) {
+Application2D::Application2D() : m_window(nullptr), m_gameOver(false), m_input(new Input()), renderer2D(nullptr) {
 	glfwInit();
 }
 
@@ -36,6 +37,10 @@ Application2D::Application2D() : m_gameOver(false), m_window(nullptr) {
 */
 bool Application2D::createWindow(int width, int height, const char * title, bool fullScreen) {
 	bool windowCreated = false;
+#ifdef OPENGLFW_GL_DEBUG
+	// some drivers only report performance messages to a debug context
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 	m_window = glfwCreateWindow(width, height, title,
 		(fullScreen ? glfwGetPrimaryMonitor() : nullptr),
 								nullptr);
@@ -44,13 +49,20 @@ bool Application2D::createWindow(int width, int height, const char * title, bool
 		return windowCreated;
 	}
 	windowCreated = true;
-	// viewport matches the new window dimensions
-	glfwSetFramebufferSizeCallback(m_window, [](GLFWwindow*, int w, int h) {glViewport(0, 0, w, h); });
+	// buffer the keyboard, mouse and resize events of the window
+	m_input->attach(m_window);
 	// GLFW - Make the window's context current
 	glfwMakeContextCurrent(m_window);
 
+#ifdef OPENGLFW_GL_LOAD_ON_DEMAND
+	// GLAD - load the OpenGL 3.3 function pointers the renderer starts with,
+	// the newer versions are loaded by GLCaps when it probes their features
+	int loaded = gladLoadGLLoaderVersion((GLADloadproc)glfwGetProcAddress, 3, 3);
+#else
 	// GLAD - load all OpenGL function pointers
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+	int loaded = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+#endif
+	if (!loaded) {
 		windowCreated = false;
 		std::cout << "Failed to initialize GLAD" << std::endl;
 		return windowCreated;
@@ -60,7 +72,7 @@ bool Application2D::createWindow(int width, int height, const char * title, bool
 }
 
 void Application2D::quit() {
-	if (glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+	if (m_input->isKeyDown(GLFW_KEY_ESCAPE)) {
 		m_gameOver = true;
 	}
 	// set it true if the escape key or close button is pressed
@@ -71,56 +83,57 @@ void Application2D::quit() {
 void Application2D::runApp(const char * title, int width, int height, bool fullscreen) {
 	// check if the window has been successfully created
 	if (createWindow(width, height, title, fullscreen)) {
+		renderer2D = new Renderer2D();
 		start();
 		// GLFW - Loop until the user closes the window
 		while (!m_gameOver) {
-			// input from the user to close the window
-			quit();
-
-			// Render here
-			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-			glClear(GL_COLOR_BUFFER_BIT);
-
 			// check for any keys or mouse movements
 			glfwPollEvents();
+			// snapshot the buffered input for this frame
+			m_input->update();
+			// the renderer keeps the size, so nothing is queried while drawing
+			if (m_input->wasResized()) {
+				renderer2D->resize(m_input->getFramebufferWidth(), m_input->getFramebufferHeight(),
+					m_input->getContentScaleX(), m_input->getContentScaleY());
+			}
 
+			// input from the user to close the window
+			quit();
+
+			// Render here, the screen is cleared once by the load actions of renderer2D->begin()
 			draw();
+			// the bookkeeping of the frame, once however many passes draw() ran
+			renderer2D->endFrame();
 
 			// swap front and back buffers
 			glfwSwapBuffers(m_window);
+			// report the GL calls of the frame when they are profiled
+			GL_PROFILER_END_FRAME();
 		}
 	}
+	// the renderer deletes its GL objects, so it goes while the context is still current
+	delete renderer2D;
+	renderer2D = nullptr;
 	glfwDestroyWindow(m_window);
 	glfwTerminate();
 }
 
 void Application2D::start() {
-	renderer2D = new Renderer2D();
 }
 
 void Application2D::draw() {
-	// clear the screen each frame before drawing
-	clearScreen();
-	// begin drawing by using the shader program
+	// an empty frame, begin clears the screen
 	renderer2D->begin();
-
-	// draw here
-	renderer2D->drawPoint(100.0f, 500.0f, 5.0f);
-	renderer2D->drawPoint(500.0f, 200.0f, 2.0f);
-	renderer2D->SetColor(1.0f, 0.4f, 0.2f, 1.0f);
-	renderer2D->drawTriangle(200.0f, 150.0f, 600.0f, 150.0f, 400.0f, 450.0f);
-	renderer2D->drawRectangle(0.0f, 50.0f, 50.0f, 50.0f, 50.0f, 0.0f, 0.0f, 0.0f);
-	renderer2D->drawLine(200.0f, 400.0f, 700.0f, 100.0f, 5.0f);
-	renderer2D->drawCircle(0.0f, 200.0f, 10.0f);
-
 	renderer2D->end();
 }
 
 void Application2D::clearScreen() {
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
 
 Application2D::~Application2D() {
-	delete renderer2D;
+	// the renderer is deleted by runApp before the window and its context go
+	delete m_input;
 }
 
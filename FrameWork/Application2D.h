@@ -6,7 +6,7 @@
 * File: Application2D.h
 *
 * Description:	Create an OpenGL window and render the sprites drawn on the screen.
-*				The scripts for the game should be added in this class.
+*				The scripts for the game should be added in a class derived from this one.
 *
 * Author: Ramkumar Thiyagarajan
 *
@@ -18,6 +18,7 @@
 #define APPLICATION2D_H_
 
 #include "Renderer2D.h"
+#include "Input.h"
 
 struct GLFWwindow;
 class Application2D {
@@ -28,14 +29,20 @@ public:
 	/* GLFW - render loop */
 	void runApp(const char* title, int width, int height, bool fullscreen = false);
 
-	void start();
+	/* called once the window and the renderer exist, load the game here */
+	virtual void start();
 
-	void draw();
+	/* called every frame, draw the game here */
+	virtual void draw();
 
-	/* refreshes the screen */
+	/* clears the screen with one call, only for frames not started with renderer2D->begin(),
+	   which clears with the load actions of its pass */
 	void clearScreen();
 
-	~Application2D();
+	/* keyboard and mouse state of the current frame */
+	const Input* getInput() const { return m_input; }
+
+	virtual ~Application2D();
 
 protected:
 	/* GLFW - window creation */
@@ -48,6 +55,9 @@ protected:
 
 	bool m_gameOver;
 
+	/* buffered keyboard and mouse input */
+	Input* m_input;
+
 	/* Application stuff */
 	Renderer2D* renderer2D;
 };
@@ -0,0 +1,145 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Camera2D.cpp
+*
+* Description:	2D camera with pan, zoom, rotation and a viewport rectangle.
+*				Builds the view and projection matrices of the renderer and the
+*				world space bounds the draw calls are culled against.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Camera2D.h"
+#include <glm/ext.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace {
+	inline void store(float* out, const glm::mat4& m) {
+		const float* p = glm::value_ptr(m);
+		std::copy(p, p + 16, out);
+	}
+}
+
+Camera2D::Camera2D() {
+	m_x = 0.0f;
+	m_y = 0.0f;
+	m_zoom = 1.0f;
+	m_rotation = 0.0f;
+	std::fill(m_viewport, m_viewport + 4, 0);
+	std::fill(m_resolvedViewport, m_resolvedViewport + 4, 0);
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	m_dirty = true;
+
+	store(m_view, glm::mat4(1.0f));
+	store(m_inverseView, glm::mat4(1.0f));
+	store(m_projection, glm::mat4(1.0f));
+	store(m_viewProjection, glm::mat4(1.0f));
+
+	// nothing is culled until the first update
+	float infinity = std::numeric_limits<float>::infinity();
+	m_bounds[0] = -infinity;
+	m_bounds[1] = -infinity;
+	m_bounds[2] = infinity;
+	m_bounds[3] = infinity;
+}
+
+void Camera2D::setPosition(float x, float y) {
+	m_x = x;
+	m_y = y;
+	m_dirty = true;
+}
+
+void Camera2D::move(float dx, float dy) {
+	m_x += dx;
+	m_y += dy;
+	m_dirty = true;
+}
+
+void Camera2D::setZoom(float zoom) {
+	// a zoom of 0 would collapse the view
+	m_zoom = glm::max(zoom, 1e-6f);
+	m_dirty = true;
+}
+
+void Camera2D::setRotation(float rotation) {
+	m_rotation = rotation;
+	m_dirty = true;
+}
+
+void Camera2D::setViewport(int x, int y, int width, int height) {
+	m_viewport[0] = x;
+	m_viewport[1] = y;
+	m_viewport[2] = glm::max(width, 0);
+	m_viewport[3] = glm::max(height, 0);
+	m_dirty = true;
+}
+
+void Camera2D::getViewport(int& x, int& y, int& width, int& height) const {
+	x = m_resolvedViewport[0];
+	y = m_resolvedViewport[1];
+	width = m_resolvedViewport[2];
+	height = m_resolvedViewport[3];
+}
+
+bool Camera2D::update(int windowWidth, int windowHeight) {
+	if (!m_dirty && windowWidth == m_windowWidth && windowHeight == m_windowHeight) {
+		return false;
+	}
+	m_dirty = false;
+	m_windowWidth = windowWidth;
+	m_windowHeight = windowHeight;
+
+	bool full = (m_viewport[2] == 0 || m_viewport[3] == 0);
+	m_resolvedViewport[0] = (full ? 0 : m_viewport[0]);
+	m_resolvedViewport[1] = (full ? 0 : m_viewport[1]);
+	m_resolvedViewport[2] = (full ? windowWidth : m_viewport[2]);
+	m_resolvedViewport[3] = (full ? windowHeight : m_viewport[3]);
+	float width = (float)glm::max(m_resolvedViewport[2], 1);
+	float height = (float)glm::max(m_resolvedViewport[3], 1);
+
+	// pan, then zoom and rotate around the viewport center
+	glm::vec3 center(width * 0.5f, height * 0.5f, 0.0f);
+	glm::mat4 view = glm::translate(glm::mat4(1.0f), center);
+	view = glm::rotate(view, -m_rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+	view = glm::scale(view, glm::vec3(m_zoom, m_zoom, 1.0f));
+	view = glm::translate(view, -center - glm::vec3(m_x, m_y, 0.0f));
+	glm::mat4 inverseView = glm::inverse(view);
+
+	// the renderer spreads layers over z 0 at the front to 100 at the back, the near and far
+	// values put z -1 on the near plane and z 101 on the far plane, so a larger z is farther
+	glm::mat4 projection = glm::ortho(0.0f, width, 0.0f, height, 1.0f, -101.0f);
+
+	store(m_view, view);
+	store(m_inverseView, inverseView);
+	store(m_projection, projection);
+	store(m_viewProjection, projection * view);
+
+	// the visible box is the world space box around the four viewport corners
+	glm::vec2 corners[] = { glm::vec2(0.0f, 0.0f), glm::vec2(width, 0.0f), glm::vec2(0.0f, height), glm::vec2(width, height) };
+	glm::vec2 minimum(std::numeric_limits<float>::max());
+	glm::vec2 maximum(-std::numeric_limits<float>::max());
+	for (const glm::vec2& corner : corners) {
+		glm::vec2 world = glm::vec2(inverseView * glm::vec4(corner, 0.0f, 1.0f));
+		minimum = glm::min(minimum, world);
+		maximum = glm::max(maximum, world);
+	}
+	m_bounds[0] = minimum.x;
+	m_bounds[1] = minimum.y;
+	m_bounds[2] = maximum.x;
+	m_bounds[3] = maximum.y;
+	return true;
+}
+
+void Camera2D::viewportToWorld(float x, float y, float& worldX, float& worldY) const {
+	glm::vec4 world = glm::make_mat4(m_inverseView) * glm::vec4(x, y, 0.0f, 1.0f);
+	worldX = world.x;
+	worldY = world.y;
+}
@@ -0,0 +1,85 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Camera2D.h
+*
+* Description:	2D camera with pan, zoom, rotation and a viewport rectangle.
+*				Builds the view and projection matrices of the renderer and the
+*				world space bounds the draw calls are culled against.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef CAMERA2D_H_
+#define CAMERA2D_H_
+
+class Camera2D {
+public:
+	Camera2D();
+
+	// world point at the bottom left of the viewport before zoom and rotation,
+	// at 0, 0 one world unit is one window unit with the origin at the bottom left
+	void setPosition(float x, float y);
+	void move(float dx, float dy);
+	float getX() const { return m_x; }
+	float getY() const { return m_y; }
+
+	// magnification around the viewport center, 2 shows everything twice as large
+	void setZoom(float zoom);
+	float getZoom() const { return m_zoom; }
+
+	// counter clockwise rotation of the camera around the viewport center in radians,
+	// the world appears turned the other way
+	void setRotation(float rotation);
+	float getRotation() const { return m_rotation; }
+
+	// part of the window drawn into, in window units from the bottom left,
+	// a width or height of 0 covers the whole window
+	void setViewport(int x, int y, int width, int height);
+
+	// viewport resolved against the window size of the last update
+	void getViewport(int& x, int& y, int& width, int& height) const;
+
+	// rebuilds the matrices and the visible bounds if the camera or the window size changed,
+	// called by Renderer2D::begin
+	// @param windowWidth, windowHeight - size the viewport is resolved against
+	// @return true if the matrices changed
+	bool update(int windowWidth, int windowHeight);
+
+	// column major 4x4 matrices
+	const float* getViewMatrix() const { return m_view; }
+	const float* getProjectionMatrix() const { return m_projection; }
+	const float* getViewProjectionMatrix() const { return m_viewProjection; }
+
+	// axis aligned world space box seen through the viewport as min x, min y, max x, max y
+	const float* getVisibleBounds() const { return m_bounds; }
+
+	// converts a point in window units relative to the bottom left of the viewport into world space
+	void viewportToWorld(float x, float y, float& worldX, float& worldY) const;
+
+protected:
+	float m_x, m_y;
+	float m_zoom;
+	float m_rotation;
+
+	// requested viewport, and the one resolved by update
+	int m_viewport[4];
+	int m_resolvedViewport[4];
+
+	// window size of the last update, and whether a setter ran since
+	int m_windowWidth, m_windowHeight;
+	bool m_dirty;
+
+	float m_view[16];
+	float m_inverseView[16];
+	float m_projection[16];
+	float m_viewProjection[16];
+	float m_bounds[4];
+};
+
+#endif // !CAMERA2D_H_
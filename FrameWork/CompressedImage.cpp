@@ -0,0 +1,703 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: CompressedImage.cpp
+*
+* Description:	Reads KTX and KTX2 files holding BC1, BC3, BC7, ETC2 or plain RGBA8 images
+*				with their mip chains, and decodes the blocks to RGBA8 on the CPU for
+*				contexts that cannot sample a format.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "CompressedImage.h"
+#include "GLCaps.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	// EXT_texture_compression_s3tc and EXT_texture_sRGB, never core so glad does not define them
+	const unsigned int GL_RGB_S3TC_DXT1 = 0x83F0;
+	const unsigned int GL_RGBA_S3TC_DXT1 = 0x83F1;
+	const unsigned int GL_RGBA_S3TC_DXT5 = 0x83F3;
+	const unsigned int GL_SRGB_S3TC_DXT1 = 0x8C4C;
+	const unsigned int GL_SRGB_ALPHA_S3TC_DXT1 = 0x8C4D;
+	const unsigned int GL_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F;
+
+	const unsigned char KTX1_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+	const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+	const unsigned int KTX1_HEADER_BYTES = 64;
+	const unsigned int KTX2_HEADER_BYTES = 80;
+	const unsigned int KTX2_LEVEL_BYTES = 24;
+	const unsigned int MAX_LEVELS = 16;
+
+	// modifiers of the ETC1 and ETC2 individual and differential modes, per table codeword
+	const int ETC_MODIFIERS[8][2] = {
+		{ 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+	};
+	// distances of the ETC2 T and H modes
+	const int ETC_DISTANCES[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+	// modifiers of the EAC alpha block, per table index
+	const int EAC_MODIFIERS[16][8] = {
+		{ -3, -6, -9, -15, 2, 5, 8, 14 },
+		{ -3, -7, -10, -13, 2, 6, 9, 12 },
+		{ -2, -5, -8, -13, 1, 4, 7, 12 },
+		{ -2, -4, -6, -13, 1, 3, 5, 12 },
+		{ -3, -6, -8, -12, 2, 5, 7, 11 },
+		{ -3, -7, -9, -11, 2, 6, 8, 10 },
+		{ -4, -7, -8, -11, 3, 6, 7, 10 },
+		{ -3, -5, -8, -11, 2, 4, 7, 10 },
+		{ -2, -6, -8, -10, 1, 5, 7, 9 },
+		{ -2, -5, -8, -10, 1, 4, 7, 9 },
+		{ -2, -4, -8, -10, 1, 3, 7, 9 },
+		{ -2, -5, -7, -10, 1, 4, 6, 9 },
+		{ -3, -4, -7, -10, 2, 3, 6, 9 },
+		{ -1, -2, -3, -10, 0, 1, 2, 9 },
+		{ -4, -6, -8, -9, 3, 5, 7, 8 },
+		{ -3, -5, -7, -9, 2, 4, 6, 8 }
+	};
+
+	unsigned int readUint(const unsigned char* data) {
+		return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+	}
+
+	unsigned long long readUint64(const unsigned char* data) {
+		return readUint(data) | ((unsigned long long)readUint(data + 4) << 32);
+	}
+
+	unsigned char clampColor(int value) {
+		return (unsigned char)std::min(255, std::max(0, value));
+	}
+
+	/**
+	* Maps the internal format of a KTX file to a format
+	* @return false if it is none of them
+	*/
+	bool ktx1Format(unsigned int internalFormat, unsigned int type, CompressedImage::Format& format) {
+		switch (internalFormat) {
+		case GL_RGBA8:
+		case GL_SRGB8_ALPHA8:
+			format = CompressedImage::FORMAT_RGBA8;
+			return type == GL_UNSIGNED_BYTE;
+		case GL_RGB_S3TC_DXT1:
+		case GL_SRGB_S3TC_DXT1:
+			format = CompressedImage::FORMAT_BC1;
+			return true;
+		case GL_RGBA_S3TC_DXT1:
+		case GL_SRGB_ALPHA_S3TC_DXT1:
+			format = CompressedImage::FORMAT_BC1_ALPHA;
+			return true;
+		case GL_RGBA_S3TC_DXT5:
+		case GL_SRGB_ALPHA_S3TC_DXT5:
+			format = CompressedImage::FORMAT_BC3;
+			return true;
+		case GL_COMPRESSED_RGBA_BPTC_UNORM:
+		case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+			format = CompressedImage::FORMAT_BC7;
+			return true;
+		case GL_COMPRESSED_RGB8_ETC2:
+		case GL_COMPRESSED_SRGB8_ETC2:
+			format = CompressedImage::FORMAT_ETC2_RGB;
+			return true;
+		case GL_COMPRESSED_RGBA8_ETC2_EAC:
+		case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+			format = CompressedImage::FORMAT_ETC2_RGBA;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	* Maps the VkFormat of a KTX2 file to a format
+	* @return false if it is none of them
+	*/
+	bool ktx2Format(unsigned int vkFormat, CompressedImage::Format& format) {
+		switch (vkFormat) {
+		// VK_FORMAT_R8G8B8A8_UNORM and _SRGB
+		case 37:
+		case 43:
+			format = CompressedImage::FORMAT_RGBA8;
+			return true;
+		// VK_FORMAT_BC1_RGB_UNORM_BLOCK and _SRGB_BLOCK
+		case 131:
+		case 132:
+			format = CompressedImage::FORMAT_BC1;
+			return true;
+		// VK_FORMAT_BC1_RGBA_UNORM_BLOCK and _SRGB_BLOCK
+		case 133:
+		case 134:
+			format = CompressedImage::FORMAT_BC1_ALPHA;
+			return true;
+		// VK_FORMAT_BC3_UNORM_BLOCK and _SRGB_BLOCK
+		case 137:
+		case 138:
+			format = CompressedImage::FORMAT_BC3;
+			return true;
+		// VK_FORMAT_BC7_UNORM_BLOCK and _SRGB_BLOCK
+		case 145:
+		case 146:
+			format = CompressedImage::FORMAT_BC7;
+			return true;
+		// VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK and _SRGB_BLOCK
+		case 147:
+		case 148:
+			format = CompressedImage::FORMAT_ETC2_RGB;
+			return true;
+		// VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK and _SRGB_BLOCK
+		case 151:
+		case 152:
+			format = CompressedImage::FORMAT_ETC2_RGBA;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	* Checks the size of the image and the number of levels and sets them on image
+	*/
+	bool setSize(CompressedImage& image, unsigned int width, unsigned int height, unsigned int levels) {
+		if (width == 0 || height == 0 || width > 1 << 16 || height > 1 << 16) {
+			return false;
+		}
+		unsigned int fullChain = 1;
+		while ((std::max(width, height) >> fullChain) > 0) {
+			++fullChain;
+		}
+		if (levels == 0 || levels > fullChain || levels > MAX_LEVELS) {
+			return false;
+		}
+		image.width = width;
+		image.height = height;
+		image.levels.resize(levels);
+		for (unsigned int i = 0; i < levels; ++i) {
+			image.levels[i].width = std::max(1u, width >> i);
+			image.levels[i].height = std::max(1u, height >> i);
+			image.levels[i].size = CompressedImage::levelSize(image.format, image.levels[i].width, image.levels[i].height);
+		}
+		return true;
+	}
+
+	/**
+	* Reads the row order from the KTXorientation key of the key and value data
+	* @param data - first key and value pair, each is its size, the key, a zero and the value
+	* @param bytes - size of all pairs
+	* @return false if the value says the rows go up, true for down and if there is no key
+	*/
+	bool readTopFirst(const unsigned char* data, size_t bytes) {
+		static const char KEY[] = "KTXorientation";
+		size_t offset = 0;
+		while (offset + 4 <= bytes) {
+			size_t length = readUint(data + offset);
+			offset += 4;
+			if (length > bytes - offset) {
+				break;
+			}
+			const char* entry = (const char*)(data + offset);
+			if (length > sizeof(KEY) && memcmp(entry, KEY, sizeof(KEY)) == 0) {
+				// KTX writes S=r,T=d and KTX2 writes rd, the first u or d is the direction of the rows
+				for (size_t i = sizeof(KEY); i < length; ++i) {
+					if (entry[i] == 'u' || entry[i] == 'd') {
+						return entry[i] == 'd';
+					}
+				}
+				return true;
+			}
+			offset += (length + 3) & ~(size_t)3;
+		}
+		return true;
+	}
+
+	bool parseKtx1(const unsigned char* data, size_t size, CompressedImage& image) {
+		if (size < KTX1_HEADER_BYTES || readUint(data + 12) != 0x04030201) {
+			return false;
+		}
+		unsigned int type = readUint(data + 16);
+		unsigned int internalFormat = readUint(data + 28);
+		unsigned int depth = readUint(data + 44);
+		unsigned int arrayElements = readUint(data + 48);
+		unsigned int faces = readUint(data + 52);
+		unsigned int levels = std::max(1u, readUint(data + 56));
+		unsigned int keyValueBytes = readUint(data + 60);
+		if (depth != 0 || arrayElements != 0 || faces != 1 || !ktx1Format(internalFormat, type, image.format)) {
+			return false;
+		}
+		if (!setSize(image, readUint(data + 36), readUint(data + 40), levels)) {
+			return false;
+		}
+		if (keyValueBytes > size - KTX1_HEADER_BYTES) {
+			return false;
+		}
+		image.topFirst = readTopFirst(data + KTX1_HEADER_BYTES, keyValueBytes);
+
+		// each level is its size and its data, padded to 4 bytes
+		size_t offset = (size_t)KTX1_HEADER_BYTES + keyValueBytes;
+		for (size_t i = 0; i < image.levels.size(); ++i) {
+			if (offset + 4 > size || readUint(data + offset) != image.levels[i].size) {
+				return false;
+			}
+			image.levels[i].offset = offset + 4;
+			offset += 4 + ((image.levels[i].size + 3) & ~(size_t)3);
+			if (image.levels[i].offset + image.levels[i].size > size) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool parseKtx2(const unsigned char* data, size_t size, CompressedImage& image) {
+		if (size < KTX2_HEADER_BYTES) {
+			return false;
+		}
+		unsigned int vkFormat = readUint(data + 12);
+		unsigned int depth = readUint(data + 28);
+		unsigned int layers = readUint(data + 32);
+		unsigned int faces = readUint(data + 36);
+		unsigned int levels = std::max(1u, readUint(data + 40));
+		unsigned int supercompression = readUint(data + 44);
+		if (depth != 0 || layers != 0 || faces != 1 || supercompression != 0 || !ktx2Format(vkFormat, image.format)) {
+			return false;
+		}
+		if (!setSize(image, readUint(data + 20), readUint(data + 24), levels)) {
+			return false;
+		}
+		unsigned int keyValueOffset = readUint(data + 56);
+		unsigned int keyValueBytes = readUint(data + 60);
+		if (keyValueOffset > size || keyValueBytes > size - keyValueOffset) {
+			return false;
+		}
+		image.topFirst = readTopFirst(data + keyValueOffset, keyValueBytes);
+
+		// the level index starts with the base level, the data starts with the smallest
+		if (size < KTX2_HEADER_BYTES + (size_t)levels * KTX2_LEVEL_BYTES) {
+			return false;
+		}
+		for (size_t i = 0; i < image.levels.size(); ++i) {
+			const unsigned char* entry = data + KTX2_HEADER_BYTES + i * KTX2_LEVEL_BYTES;
+			unsigned long long offset = readUint64(entry);
+			unsigned long long length = readUint64(entry + 8);
+			if (length != image.levels[i].size || offset > size || length > size - offset) {
+				return false;
+			}
+			image.levels[i].offset = (size_t)offset;
+		}
+		return true;
+	}
+
+	/**
+	* Expands a 565 color to 8 bits per channel
+	*/
+	void expand565(unsigned int color, int* rgb) {
+		int r = (color >> 11) & 0x1F;
+		int g = (color >> 5) & 0x3F;
+		int b = color & 0x1F;
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	/**
+	* Decodes the color half of a BC1, BC2 or BC3 block
+	* @param threeColor - the block may use the mode with 3 colors and transparent black,
+	*        only BC1 has it
+	* @param alpha - transparent black is opaque black without it
+	* @param texels - 16 rgba texels, row by row
+	*/
+	void decodeBc1(const unsigned char* block, bool threeColor, bool alpha, unsigned char* texels) {
+		unsigned int color0 = block[0] | (block[1] << 8);
+		unsigned int color1 = block[2] | (block[3] << 8);
+		int palette[4][4];
+		expand565(color0, palette[0]);
+		expand565(color1, palette[1]);
+		for (int c = 0; c < 3; ++c) {
+			if (color0 > color1 || !threeColor) {
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else {
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		palette[0][3] = palette[1][3] = palette[2][3] = 255;
+		palette[3][3] = (color0 <= color1 && threeColor && alpha) ? 0 : 255;
+
+		unsigned int indices = readUint(block + 4);
+		for (int i = 0; i < 16; ++i) {
+			const int* color = palette[(indices >> (2 * i)) & 3];
+			texels[i * 4 + 0] = (unsigned char)color[0];
+			texels[i * 4 + 1] = (unsigned char)color[1];
+			texels[i * 4 + 2] = (unsigned char)color[2];
+			texels[i * 4 + 3] = (unsigned char)color[3];
+		}
+	}
+
+	/**
+	* Decodes the alpha half of a BC3 block over the alpha of texels
+	*/
+	void decodeBc3Alpha(const unsigned char* block, unsigned char* texels) {
+		int alpha0 = block[0];
+		int alpha1 = block[1];
+		int palette[8];
+		palette[0] = alpha0;
+		palette[1] = alpha1;
+		if (alpha0 > alpha1) {
+			for (int i = 1; i < 7; ++i) {
+				palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+			}
+		}
+		else {
+			for (int i = 1; i < 5; ++i) {
+				palette[i + 1] = ((5 - i) * alpha0 + i * alpha1) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		unsigned long long indices = 0;
+		for (int i = 0; i < 6; ++i) {
+			indices |= (unsigned long long)block[2 + i] << (8 * i);
+		}
+		for (int i = 0; i < 16; ++i) {
+			texels[i * 4 + 3] = (unsigned char)palette[(indices >> (3 * i)) & 7];
+		}
+	}
+
+	/**
+	* Decodes an ETC2 RGB block, ETC1 blocks decode the same
+	* @param texels - 16 rgba texels, row by row, alpha is set to 255
+	*/
+	void decodeEtc2(const unsigned char* block, unsigned char* texels) {
+		int colors[2][3];
+		// texels pick one of 4 paint colors in the T and H modes, or
+		// modify the color of their half of the block in the other modes
+		int paint[4][3];
+		bool paintMode = false;
+		bool differential = (block[3] & 2) != 0;
+		bool flip = (block[3] & 1) != 0;
+
+		if (!differential) {
+			for (int c = 0; c < 3; ++c) {
+				colors[0][c] = (block[c] >> 4) * 17;
+				colors[1][c] = (block[c] & 0xF) * 17;
+			}
+		}
+		else {
+			int base[3], delta[3];
+			for (int c = 0; c < 3; ++c) {
+				base[c] = block[c] >> 3;
+				delta[c] = ((block[c] & 7) ^ 4) - 4;
+			}
+
+			// a second color outside 0-31 selects one of the ETC2 modes, red for T, green for H, blue for planar
+			if (base[0] + delta[0] < 0 || base[0] + delta[0] > 31) {
+				int first[3] = { ((block[0] >> 1) & 0xC) | (block[0] & 3), block[1] >> 4, block[1] & 0xF };
+				int second[3] = { block[2] >> 4, block[2] & 0xF, block[3] >> 4 };
+				int distance = ETC_DISTANCES[((block[3] >> 1) & 6) | (block[3] & 1)];
+				for (int c = 0; c < 3; ++c) {
+					paint[0][c] = first[c] * 17;
+					paint[1][c] = clampColor(second[c] * 17 + distance);
+					paint[2][c] = second[c] * 17;
+					paint[3][c] = clampColor(second[c] * 17 - distance);
+				}
+				paintMode = true;
+			}
+			else if (base[1] + delta[1] < 0 || base[1] + delta[1] > 31) {
+				int first[3] = {
+					(block[0] >> 3) & 0xF,
+					((block[0] & 7) << 1) | ((block[1] >> 4) & 1),
+					(block[1] & 8) | ((block[1] & 3) << 1) | (block[2] >> 7)
+				};
+				int second[3] = { (block[2] >> 3) & 0xF, ((block[2] & 7) << 1) | (block[3] >> 7), (block[3] >> 3) & 0xF };
+				int firstValue = (first[0] << 8) | (first[1] << 4) | first[2];
+				int secondValue = (second[0] << 8) | (second[1] << 4) | second[2];
+				int distance = ETC_DISTANCES[(block[3] & 4) | ((block[3] & 1) << 1) | (firstValue >= secondValue ? 1 : 0)];
+				for (int c = 0; c < 3; ++c) {
+					paint[0][c] = clampColor(first[c] * 17 + distance);
+					paint[1][c] = clampColor(first[c] * 17 - distance);
+					paint[2][c] = clampColor(second[c] * 17 + distance);
+					paint[3][c] = clampColor(second[c] * 17 - distance);
+				}
+				paintMode = true;
+			}
+			else if (base[2] + delta[2] < 0 || base[2] + delta[2] > 31) {
+				// planar, the colors at the origin, the right and the bottom are interpolated
+				int origin[3] = {
+					(block[0] >> 1) & 0x3F,
+					((block[0] & 1) << 6) | ((block[1] >> 1) & 0x3F),
+					((block[1] & 1) << 5) | (((block[2] >> 3) & 3) << 3) | ((block[2] & 3) << 1) | (block[3] >> 7)
+				};
+				int horizontal[3] = {
+					(((block[3] >> 2) & 0x1F) << 1) | (block[3] & 1),
+					block[4] >> 1,
+					((block[4] & 1) << 5) | (block[5] >> 3)
+				};
+				int vertical[3] = {
+					((block[5] & 7) << 3) | (block[6] >> 5),
+					((block[6] & 0x1F) << 2) | (block[7] >> 6),
+					block[7] & 0x3F
+				};
+				for (int c = 0; c < 3; ++c) {
+					// green has 7 bits, red and blue 6
+					int bits = c == 1 ? 7 : 6;
+					origin[c] = (origin[c] << (8 - bits)) | (origin[c] >> (2 * bits - 8));
+					horizontal[c] = (horizontal[c] << (8 - bits)) | (horizontal[c] >> (2 * bits - 8));
+					vertical[c] = (vertical[c] << (8 - bits)) | (vertical[c] >> (2 * bits - 8));
+				}
+				for (int y = 0; y < 4; ++y) {
+					for (int x = 0; x < 4; ++x) {
+						unsigned char* texel = texels + (y * 4 + x) * 4;
+						for (int c = 0; c < 3; ++c) {
+							texel[c] = clampColor((x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2);
+						}
+						texel[3] = 255;
+					}
+				}
+				return;
+			}
+			else {
+				for (int c = 0; c < 3; ++c) {
+					int second = base[c] + delta[c];
+					colors[0][c] = (base[c] << 3) | (base[c] >> 2);
+					colors[1][c] = (second << 3) | (second >> 2);
+				}
+			}
+		}
+
+		// the indices run down the columns, the most significant bits in the first two bytes
+		unsigned int indices = (block[4] << 24) | (block[5] << 16) | (block[6] << 8) | block[7];
+		int tables[2] = { block[3] >> 5, (block[3] >> 2) & 7 };
+		for (int x = 0; x < 4; ++x) {
+			for (int y = 0; y < 4; ++y) {
+				int bit = x * 4 + y;
+				int index = (((indices >> (16 + bit)) & 1) << 1) | ((indices >> bit) & 1);
+				unsigned char* texel = texels + (y * 4 + x) * 4;
+				if (paintMode) {
+					texel[0] = (unsigned char)paint[index][0];
+					texel[1] = (unsigned char)paint[index][1];
+					texel[2] = (unsigned char)paint[index][2];
+				}
+				else {
+					// the block splits into two halves side by side, or on top of each other when flipped
+					int half = flip ? (y >= 2) : (x >= 2);
+					int modifier = ETC_MODIFIERS[tables[half]][index & 1];
+					if (index & 2) {
+						modifier = -modifier;
+					}
+					for (int c = 0; c < 3; ++c) {
+						texel[c] = clampColor(colors[half][c] + modifier);
+					}
+				}
+				texel[3] = 255;
+			}
+		}
+	}
+
+	/**
+	* Decodes an EAC alpha block over the alpha of texels
+	*/
+	void decodeEac(const unsigned char* block, unsigned char* texels) {
+		int base = block[0];
+		int multiplier = block[1] >> 4;
+		const int* modifiers = EAC_MODIFIERS[block[1] & 0xF];
+		unsigned long long indices = 0;
+		for (int i = 2; i < 8; ++i) {
+			indices = (indices << 8) | block[i];
+		}
+		// 3 bits per texel down the columns, the first texel in the most significant bits
+		for (int x = 0; x < 4; ++x) {
+			for (int y = 0; y < 4; ++y) {
+				int index = (int)(indices >> (45 - 3 * (x * 4 + y))) & 7;
+				texels[(y * 4 + x) * 4 + 3] = clampColor(base + modifiers[index] * multiplier);
+			}
+		}
+	}
+}
+
+bool CompressedImage::isKtx(const unsigned char* data, size_t size) {
+	return size >= 12 && (memcmp(data, KTX1_IDENTIFIER, 12) == 0 || memcmp(data, KTX2_IDENTIFIER, 12) == 0);
+}
+
+bool CompressedImage::parse(const unsigned char* data, size_t size, CompressedImage& image) {
+	if (size < 12) {
+		return false;
+	}
+	if (memcmp(data, KTX1_IDENTIFIER, 12) == 0) {
+		return parseKtx1(data, size, image);
+	}
+	if (memcmp(data, KTX2_IDENTIFIER, 12) == 0) {
+		return parseKtx2(data, size, image);
+	}
+	return false;
+}
+
+int CompressedImage::blockSize(Format format) {
+	return format == FORMAT_RGBA8 ? 1 : 4;
+}
+
+int CompressedImage::blockBytes(Format format) {
+	switch (format) {
+	case FORMAT_RGBA8:
+		return 4;
+	case FORMAT_BC1:
+	case FORMAT_BC1_ALPHA:
+	case FORMAT_ETC2_RGB:
+		return 8;
+	default:
+		return 16;
+	}
+}
+
+size_t CompressedImage::levelSize(Format format, int width, int height) {
+	int block = blockSize(format);
+	return (size_t)((width + block - 1) / block) * ((height + block - 1) / block) * blockBytes(format);
+}
+
+unsigned int CompressedImage::glFormat(Format format) {
+	switch (format) {
+	case FORMAT_BC1:
+		return GL_RGB_S3TC_DXT1;
+	case FORMAT_BC1_ALPHA:
+		return GL_RGBA_S3TC_DXT1;
+	case FORMAT_BC3:
+		return GL_RGBA_S3TC_DXT5;
+	case FORMAT_BC7:
+		return GL_COMPRESSED_RGBA_BPTC_UNORM;
+	case FORMAT_ETC2_RGB:
+		return GL_COMPRESSED_RGB8_ETC2;
+	case FORMAT_ETC2_RGBA:
+		return GL_COMPRESSED_RGBA8_ETC2_EAC;
+	default:
+		return GL_RGBA8;
+	}
+}
+
+bool CompressedImage::isSupported(Format format, const GLCaps& caps) {
+	switch (format) {
+	case FORMAT_BC1:
+	case FORMAT_BC1_ALPHA:
+	case FORMAT_BC3:
+		return caps.textureS3TC;
+	case FORMAT_BC7:
+		return caps.textureBPTC;
+	case FORMAT_ETC2_RGB:
+	case FORMAT_ETC2_RGBA:
+		return caps.textureETC2;
+	default:
+		return true;
+	}
+}
+
+bool CompressedImage::canDecode(Format format) {
+	return format != FORMAT_BC7;
+}
+
+bool CompressedImage::decode(Format format, const unsigned char* blocks, int width, int height, unsigned char* rgba) {
+	if (!canDecode(format)) {
+		return false;
+	}
+	if (format == FORMAT_RGBA8) {
+		memcpy(rgba, blocks, (size_t)width * height * 4);
+		return true;
+	}
+
+	int bytes = blockBytes(format);
+	unsigned char texels[16 * 4];
+	for (int blockY = 0; blockY < height; blockY += 4) {
+		for (int blockX = 0; blockX < width; blockX += 4, blocks += bytes) {
+			switch (format) {
+			case FORMAT_BC1:
+			case FORMAT_BC1_ALPHA:
+				decodeBc1(blocks, true, format == FORMAT_BC1_ALPHA, texels);
+				break;
+			case FORMAT_BC3:
+				decodeBc1(blocks + 8, false, false, texels);
+				decodeBc3Alpha(blocks, texels);
+				break;
+			case FORMAT_ETC2_RGB:
+				decodeEtc2(blocks, texels);
+				break;
+			default:
+				decodeEtc2(blocks + 8, texels);
+				decodeEac(blocks, texels);
+				break;
+			}
+
+			// blocks on the right and bottom edges are cut to the size of the level
+			int columns = std::min(4, width - blockX);
+			int rows = std::min(4, height - blockY);
+			for (int y = 0; y < rows; ++y) {
+				memcpy(rgba + ((size_t)(blockY + y) * width + blockX) * 4, texels + y * 16, columns * 4);
+			}
+		}
+	}
+	return true;
+}
+
+bool CompressedImage::canFlip(Format format, int height) {
+	switch (format) {
+	case FORMAT_RGBA8:
+		return true;
+	case FORMAT_BC1:
+	case FORMAT_BC1_ALPHA:
+	case FORMAT_BC3:
+		// rows can only move inside their block, a partial block row would have to mix two blocks
+		return height <= 4 || height % 4 == 0;
+	default:
+		return false;
+	}
+}
+
+bool CompressedImage::flip(Format format, unsigned char* blocks, int width, int height) {
+	if (!canFlip(format, height)) {
+		return false;
+	}
+
+	// the rows of blocks swap first
+	int block = blockSize(format);
+	int blockRows = (height + block - 1) / block;
+	size_t rowBytes = levelSize(format, width, height) / blockRows;
+	std::vector<unsigned char> row(rowBytes);
+	for (int top = 0, bottom = blockRows - 1; top < bottom; ++top, --bottom) {
+		memcpy(row.data(), blocks + top * rowBytes, rowBytes);
+		memcpy(blocks + top * rowBytes, blocks + bottom * rowBytes, rowBytes);
+		memcpy(blocks + bottom * rowBytes, row.data(), rowBytes);
+	}
+	if (format == FORMAT_RGBA8) {
+		return true;
+	}
+
+	// then the index rows inside each block, a level less than 4 pixels high only uses its first rows
+	int rows = std::min(height, 4);
+	int bytes = blockBytes(format);
+	size_t count = levelSize(format, width, height) / bytes;
+	for (size_t i = 0; i < count; ++i) {
+		unsigned char* data = blocks + i * bytes;
+		if (format == FORMAT_BC3) {
+			// 3-bit alpha indices, 12 bits per row after the two endpoints
+			unsigned long long indices = 0;
+			for (int b = 0; b < 6; ++b) {
+				indices |= (unsigned long long)data[2 + b] << (8 * b);
+			}
+			unsigned long long flipped = indices;
+			for (int y = 0; y < rows; ++y) {
+				flipped &= ~(0xFFFull << (12 * y));
+				flipped |= ((indices >> (12 * (rows - 1 - y))) & 0xFFF) << (12 * y);
+			}
+			for (int b = 0; b < 6; ++b) {
+				data[2 + b] = (unsigned char)(flipped >> (8 * b));
+			}
+			data += 8;
+		}
+		// 2-bit color indices, one byte per row after the two endpoints
+		std::reverse(data + 4, data + 4 + rows);
+	}
+	return true;
+}
@@ -0,0 +1,91 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: CompressedImage.h
+*
+* Description:	Reads KTX and KTX2 files holding BC1, BC3, BC7, ETC2 or plain RGBA8 images
+*				with their mip chains, and decodes the blocks to RGBA8 on the CPU for
+*				contexts that cannot sample a format.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef COMPRESSEDIMAGE_H_
+#define COMPRESSEDIMAGE_H_
+
+#include <cstddef>
+#include <vector>
+
+struct GLCaps;
+struct CompressedImage {
+	// sRGB variants read as the UNORM format, the renderer blends gamma encoded colors
+	enum Format {
+		FORMAT_RGBA8,
+		// BC1 without alpha, the transparent index decodes to black
+		FORMAT_BC1,
+		FORMAT_BC1_ALPHA,
+		FORMAT_BC3,
+		FORMAT_BC7,
+		FORMAT_ETC2_RGB,
+		// ETC2 color with an EAC alpha block
+		FORMAT_ETC2_RGBA
+	};
+
+	struct Level {
+		int width, height;
+		// where the level is in the file
+		size_t offset, size;
+	};
+
+	Format format;
+	int width, height;
+	// the base level first, one level if the file has no mip chain
+	std::vector<Level> levels;
+	// true if the rows of the file start at the top, as KTXorientation says, files without it
+	// are taken as top first since that is what the KTX tools write by default
+	bool topFirst;
+
+	// true if data starts with the identifier of KTX or KTX2
+	static bool isKtx(const unsigned char* data, size_t size);
+
+	// reads the header, the orientation and the level index of a KTX or KTX2 file,
+	// rows stay in file order, flip puts the bottom row first
+	// @return false for cube maps, arrays, 3D textures, supercompressed KTX2, other formats
+	//         and files whose levels do not have the size of their format
+	static bool parse(const unsigned char* data, size_t size, CompressedImage& image);
+
+	// pixels per block side, 1 for RGBA8 and 4 for the compressed formats
+	static int blockSize(Format format);
+	static int blockBytes(Format format);
+	static size_t levelSize(Format format, int width, int height);
+
+	// internal format passed to glCompressedTexImage2D, GL_RGBA8 for RGBA8
+	static unsigned int glFormat(Format format);
+
+	// true if the context samples the format without decoding it first
+	static bool isSupported(Format format, const GLCaps& caps);
+
+	// true if decode handles the format, BC7 only goes to the GPU
+	static bool canDecode(Format format);
+
+	// decodes a level to RGBA8 rows in the same order as the blocks
+	// @param rgba - width * height * 4 bytes
+	// @return false if the format has no CPU decoder
+	static bool decode(Format format, const unsigned char* blocks, int width, int height, unsigned char* rgba);
+
+	// true if flip can reverse the rows of a level without decoding it, RGBA8 always,
+	// BC1 and BC3 if the level is a whole number of blocks high or fits in one block,
+	// BC7 and ETC2 never since their blocks split into subsets that do not mirror
+	static bool canFlip(Format format, int height);
+
+	// reverses the rows of a level in place, the rows of blocks and the index rows inside them
+	// @return false and leaves the level untouched if canFlip is false
+	static bool flip(Format format, unsigned char* blocks, int width, int height);
+};
+
+#endif // !COMPRESSEDIMAGE_H_
@@ -0,0 +1,72 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Demo2D.cpp
+*
+* Description:	Demo application drawing each of the Renderer2D primitives.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Demo2D.h"
+#include <glm/glm.hpp>
+
+void Demo2D::start() {
+	// a small bar chart submitted as one array
+	for (int i = 0; i < BAR_COUNT; ++i) {
+		Renderer2D::Rect& bar = m_bars[i];
+		bar.x = 600.0f + i * 12.0f;
+		bar.y = 450.0f;
+		bar.width = 10.0f;
+		bar.height = 10.0f + (i * 37 % 100);
+		bar.color[0] = 0.2f;
+		bar.color[1] = 0.6f + i * 0.02f;
+		bar.color[2] = 1.0f;
+		bar.color[3] = 1.0f;
+	}
+
+	// a sine wave drawn as one polyline
+	for (int i = 0; i < WAVE_POINTS; ++i) {
+		m_wave[i * 2 + 0] = 600.0f + i * 2.0f;
+		m_wave[i * 2 + 1] = 350.0f + glm::sin(i * 0.1f) * 40.0f;
+	}
+}
+
+void Demo2D::draw() {
+	// begin drawing, the default pass clears color and depth with one glClear
+	renderer2D->begin();
+
+	// draw here
+	renderer2D->drawPoint(100.0f, 500.0f, 5.0f);
+	renderer2D->drawPoint(500.0f, 200.0f, 2.0f);
+	renderer2D->SetColor(1.0f, 0.4f, 0.2f, 1.0f);
+	renderer2D->drawTriangle(200.0f, 150.0f, 600.0f, 150.0f, 400.0f, 450.0f);
+	renderer2D->drawRectangle(0.0f, 50.0f, 50.0f, 50.0f, 50.0f, 0.0f, 0.0f, 0.0f);
+	renderer2D->drawLine(200.0f, 400.0f, 700.0f, 100.0f, 5.0f);
+	renderer2D->drawCircle(0.0f, 200.0f, 10.0f);
+	renderer2D->drawRects(m_bars, BAR_COUNT);
+	renderer2D->SetColor(0.2f, 1.0f, 0.4f, 1.0f);
+	renderer2D->setLineJoin(Renderer2D::JOIN_ROUND);
+	renderer2D->drawPolyline(m_wave, WAVE_POINTS, 3.0f);
+
+	// a frame with a hole, triangulated in the first frame and then served from the cache
+	static const float frame[] = {
+		50.0f, 300.0f, 150.0f, 300.0f, 150.0f, 400.0f, 50.0f, 400.0f,
+		75.0f, 325.0f, 125.0f, 325.0f, 125.0f, 375.0f, 75.0f, 375.0f
+	};
+	static const int frameRings[] = { 4, 4 };
+	renderer2D->SetColor(0.9f, 0.8f, 0.2f, 1.0f);
+	renderer2D->drawPolygon(frame, 8, frameRings, 2);
+
+	// labels of the built-in font, both sizes come from the same atlas cells
+	renderer2D->SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+	renderer2D->drawText(50.0f, 420.0f, "OpenGLFW", 24.0f);
+	renderer2D->drawText(50.0f, 280.0f, "polygon\nwith a hole", 8.0f);
+
+	renderer2D->end();
+}
@@ -0,0 +1,36 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Demo2D.h
+*
+* Description:	Demo application drawing each of the Renderer2D primitives.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef DEMO2D_H_
+#define DEMO2D_H_
+
+#include "Application2D.h"
+
+class Demo2D : public Application2D {
+public:
+	void start() override;
+
+	void draw() override;
+
+protected:
+	enum { BAR_COUNT = 16, WAVE_POINTS = 100 };
+
+	Renderer2D::Rect m_bars[BAR_COUNT];
+
+	// x, y pairs
+	float m_wave[WAVE_POINTS * 2];
+};
+
+#endif // !DEMO2D_H_
@@ -0,0 +1,186 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GLCaps.cpp
+*
+* Description:	Detects the OpenGL version and optional features of the current context
+*				and picks the feature tier the renderer runs on.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "GLCaps.h"
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+	struct Function {
+		const char* name;
+		void** pointer;
+	};
+
+	// entry points of the optional features by their core names, which the extensions
+	// use as well, so loading them fills the same glad pointers a newer context would
+	const Function BASE_INSTANCE_FUNCTIONS[] = {
+		{ "glDrawArraysInstancedBaseInstance", (void**)&glad_glDrawArraysInstancedBaseInstance },
+		{ "glDrawElementsInstancedBaseInstance", (void**)&glad_glDrawElementsInstancedBaseInstance },
+		{ "glDrawElementsInstancedBaseVertexBaseInstance", (void**)&glad_glDrawElementsInstancedBaseVertexBaseInstance }
+	};
+	const Function DEBUG_FUNCTIONS[] = {
+		{ "glDebugMessageControl", (void**)&glad_glDebugMessageControl },
+		{ "glDebugMessageInsert", (void**)&glad_glDebugMessageInsert },
+		{ "glDebugMessageCallback", (void**)&glad_glDebugMessageCallback },
+		{ "glGetDebugMessageLog", (void**)&glad_glGetDebugMessageLog },
+		{ "glPushDebugGroup", (void**)&glad_glPushDebugGroup },
+		{ "glPopDebugGroup", (void**)&glad_glPopDebugGroup },
+		{ "glObjectLabel", (void**)&glad_glObjectLabel },
+		{ "glGetObjectLabel", (void**)&glad_glGetObjectLabel }
+	};
+	const Function INVALIDATE_FUNCTIONS[] = {
+		{ "glInvalidateFramebuffer", (void**)&glad_glInvalidateFramebuffer },
+		{ "glInvalidateSubFramebuffer", (void**)&glad_glInvalidateSubFramebuffer }
+	};
+	const Function BUFFER_STORAGE_FUNCTIONS[] = {
+		{ "glBufferStorage", (void**)&glad_glBufferStorage }
+	};
+	const Function DIRECT_STATE_ACCESS_FUNCTIONS[] = {
+		{ "glCreateBuffers", (void**)&glad_glCreateBuffers },
+		{ "glNamedBufferStorage", (void**)&glad_glNamedBufferStorage },
+		{ "glNamedBufferData", (void**)&glad_glNamedBufferData },
+		{ "glNamedBufferSubData", (void**)&glad_glNamedBufferSubData },
+		{ "glCreateVertexArrays", (void**)&glad_glCreateVertexArrays },
+		{ "glVertexArrayVertexBuffer", (void**)&glad_glVertexArrayVertexBuffer },
+		{ "glVertexArrayElementBuffer", (void**)&glad_glVertexArrayElementBuffer },
+		{ "glEnableVertexArrayAttrib", (void**)&glad_glEnableVertexArrayAttrib },
+		{ "glVertexArrayAttribFormat", (void**)&glad_glVertexArrayAttribFormat },
+		{ "glVertexArrayAttribBinding", (void**)&glad_glVertexArrayAttribBinding }
+	};
+
+	/**
+		Loads the entry points of a feature, pointers glad already loaded for the core version are kept.
+		@return true if every entry point was found
+	*/
+	template <size_t N>
+	bool loadFunctions(GLCaps::LoadProc load, const Function (&functions)[N]) {
+		bool loaded = true;
+		for (size_t i = 0; i < N; ++i) {
+			if (*functions[i].pointer == nullptr) {
+				*functions[i].pointer = load(functions[i].name);
+			}
+			loaded = loaded && *functions[i].pointer != nullptr;
+		}
+		return loaded;
+	}
+
+	const char* tierName(GLCaps::Tier tier) {
+		switch (tier) {
+		case GLCaps::TIER_GL45:
+			return "GL 4.5";
+		case GLCaps::TIER_GL43:
+			return "GL 4.3";
+		case GLCaps::TIER_GL33:
+			return "GL 3.3";
+		default:
+			return "unsupported";
+		}
+	}
+}
+
+GLCaps::GLCaps() : major(0), minor(0), tier(TIER_NONE),
+	baseInstance(false), debugOutput(false), bufferStorage(false), directStateAccess(false), invalidateFramebuffer(false),
+	textureS3TC(false), textureBPTC(false), textureETC2(false) {
+	std::strcpy(glslVersion, "#version 330 core\n");
+}
+
+void GLCaps::detect(LoadProc load) {
+	// GL_MAJOR_VERSION is core from 3.0, the loader always loads that far
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if (major < 3) {
+		// GL_MAJOR_VERSION only exists from 3.0, fall back to what glad loaded
+		major = (GLAD_GL_VERSION_2_1 ? 2 : 1);
+		minor = (GLAD_GL_VERSION_2_1 ? 1 : 0);
+	}
+	int context = major * 10 + minor;
+
+	// a feature is used when its version is core or its extension is exposed, this is
+	// decided before anything past the versions the loader started with is loaded
+	baseInstance = context >= 42 || gladHasExtension("GL_ARB_base_instance");
+	debugOutput = context >= 43 || gladHasExtension("GL_KHR_debug");
+	bufferStorage = context >= 44 || gladHasExtension("GL_ARB_buffer_storage");
+	directStateAccess = context >= 45 || gladHasExtension("GL_ARB_direct_state_access");
+	invalidateFramebuffer = context >= 43 || gladHasExtension("GL_ARB_invalidate_subdata");
+
+	// compressed formats only add internal formats, there are no entry points to load
+	textureS3TC = gladHasExtension("GL_EXT_texture_compression_s3tc");
+	textureBPTC = context >= 42 || gladHasExtension("GL_ARB_texture_compression_bptc");
+	textureETC2 = context >= 43 || gladHasExtension("GL_ARB_ES3_compatibility");
+
+	int tierVersion = 0;
+	if (baseInstance && debugOutput && bufferStorage && directStateAccess) {
+		tier = TIER_GL45;
+		tierVersion = 45;
+	}
+	else if (baseInstance && debugOutput) {
+		tier = TIER_GL43;
+		tierVersion = 43;
+	}
+	else if (context >= 33) {
+		tier = TIER_GL33;
+		tierVersion = 33;
+	}
+	else {
+		tier = TIER_NONE;
+	}
+
+	// when the loader only loaded the versions needed to start, the core version of the tier
+	// is loaded now, and a feature the context has beyond it, or only as an extension,
+	// loads just its own entry points, which the extensions name like the core functions
+	if (tierVersion > 0) {
+		gladRequireGLVersion(tierVersion / 10, tierVersion % 10);
+	}
+	baseInstance = baseInstance && loadFunctions(load, BASE_INSTANCE_FUNCTIONS);
+	debugOutput = debugOutput && loadFunctions(load, DEBUG_FUNCTIONS);
+	bufferStorage = bufferStorage && loadFunctions(load, BUFFER_STORAGE_FUNCTIONS);
+	directStateAccess = directStateAccess && loadFunctions(load, DIRECT_STATE_ACCESS_FUNCTIONS);
+	invalidateFramebuffer = invalidateFramebuffer && loadFunctions(load, INVALIDATE_FUNCTIONS);
+	if (tier == TIER_GL45 && !(bufferStorage && directStateAccess)) {
+		tier = TIER_GL43;
+	}
+	if (tier == TIER_GL43 && !(baseInstance && debugOutput)) {
+		tier = TIER_GL33;
+	}
+
+	// GLSL versions follow the GL version from 3.3 on, the shaders need at least 330
+	int version = major * 100 + minor * 10;
+	if (version < 330) {
+		version = 330;
+	}
+	else if (version > 460) {
+		version = 460;
+	}
+	std::snprintf(glslVersion, sizeof(glslVersion), "#version %d core\n", version);
+}
+
+void GLCaps::report() const {
+	const char* renderer = (const char*)glGetString(GL_RENDERER);
+	std::cout << "OpenGL " << major << "." << minor << " (" << (renderer != nullptr ? renderer : "unknown") << "), "
+		<< tierName(tier) << " tier: "
+		<< (bufferStorage ? "persistent mapped" : "orphaned") << " streaming, "
+		<< (directStateAccess ? "direct state access" : "bind-to-edit") << ", "
+		<< (baseInstance ? "base instance" : "rebound") << " point instancing, "
+		<< (invalidateFramebuffer ? "invalidated" : "kept") << " transient attachments, "
+		<< "compressed textures" << (textureS3TC ? " BC1/BC3" : "") << (textureBPTC ? " BC7" : "")
+		<< (textureETC2 ? " ETC2" : "") << (textureS3TC || textureBPTC || textureETC2 ? ", " : " decoded, ")
+		<< (debugOutput ? "debug output available" : "no debug output") << std::endl;
+	if (tier == TIER_NONE) {
+		std::cout << "ERROR::RENDERER::GL_3_3_REQUIRED" << std::endl;
+	}
+}
@@ -0,0 +1,69 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GLCaps.h
+*
+* Description:	Detects the OpenGL version and optional features of the current context
+*				and picks the feature tier the renderer runs on.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef GLCAPS_H_
+#define GLCAPS_H_
+
+struct GLCaps {
+	// code paths grouped by the GL version that made them core
+	enum Tier {
+		// below GL 3.3, the renderer may not work at all
+		TIER_NONE,
+		// orphaned streaming buffers, bind-to-edit, instancing without base instance
+		TIER_GL33,
+		// adds base instance and debug output
+		TIER_GL43,
+		// adds persistent mapped streaming buffers and direct state access
+		TIER_GL45
+	};
+
+	typedef void* (*LoadProc)(const char* name);
+
+	int major, minor;
+	Tier tier;
+
+	// glDrawArraysInstancedBaseInstance, GL 4.2 or ARB_base_instance
+	bool baseInstance;
+	// glDebugMessageCallback and glObjectLabel, GL 4.3 or KHR_debug
+	bool debugOutput;
+	// glBufferStorage for persistent mapped buffers, GL 4.4 or ARB_buffer_storage
+	bool bufferStorage;
+	// glCreate* and glNamed*, GL 4.5 or ARB_direct_state_access
+	bool directStateAccess;
+	// glInvalidateFramebuffer to drop attachments that are not needed anymore,
+	// GL 4.3 or ARB_invalidate_subdata
+	bool invalidateFramebuffer;
+	// BC1 and BC3 blocks, EXT_texture_compression_s3tc, never core but exposed by desktop drivers
+	bool textureS3TC;
+	// BC7 blocks, GL 4.2 or ARB_texture_compression_bptc
+	bool textureBPTC;
+	// ETC2 and EAC blocks, GL 4.3 or ARB_ES3_compatibility
+	bool textureETC2;
+
+	// first line of every shader, matching the context version
+	char glslVersion[32];
+
+	GLCaps();
+
+	// reads the version and extensions of the current context and picks the tier, then
+	// loads the core version of the tier and the entry points of the other features through load
+	void detect(LoadProc load);
+
+	// prints the version, the tier and the chosen code paths to the console
+	void report() const;
+};
+
+#endif // !GLCAPS_H_
@@ -0,0 +1,166 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GLDebug.cpp
+*
+* Description:	Driver messages through KHR_debug. Filters them by type and severity,
+*				collapses repeats into one line per frame with a count, and names
+*				the GL objects of the renderer so the messages point at them.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <iostream>
+
+namespace {
+	// in the order of the Renderer2D::DebugType bits
+	const GLenum TYPES[] = {
+		GL_DEBUG_TYPE_ERROR,
+		GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR,
+		GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR,
+		GL_DEBUG_TYPE_PORTABILITY,
+		GL_DEBUG_TYPE_PERFORMANCE,
+		GL_DEBUG_TYPE_OTHER
+	};
+	const char* const TYPE_NAMES[] = { "ERROR", "DEPRECATED", "UNDEFINED", "PORTABILITY", "PERFORMANCE", "OTHER" };
+	const int TYPE_COUNT = sizeof(TYPES) / sizeof(TYPES[0]);
+
+	// in the order of Renderer2D::DebugSeverity
+	const GLenum SEVERITIES[] = {
+		GL_DEBUG_SEVERITY_NOTIFICATION,
+		GL_DEBUG_SEVERITY_LOW,
+		GL_DEBUG_SEVERITY_MEDIUM,
+		GL_DEBUG_SEVERITY_HIGH
+	};
+	const char* const SEVERITY_NAMES[] = { "NOTIFICATION", "LOW", "MEDIUM", "HIGH" };
+	const int SEVERITY_COUNT = sizeof(SEVERITIES) / sizeof(SEVERITIES[0]);
+
+	const char* typeName(GLenum type) {
+		for (int i = 0; i < TYPE_COUNT; ++i) {
+			if (TYPES[i] == type) {
+				return TYPE_NAMES[i];
+			}
+		}
+		return "OTHER";
+	}
+
+	const char* severityName(GLenum severity) {
+		for (int i = 0; i < SEVERITY_COUNT; ++i) {
+			if (SEVERITIES[i] == severity) {
+				return SEVERITY_NAMES[i];
+			}
+		}
+		return "NOTIFICATION";
+	}
+
+	void APIENTRY receive(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* user) {
+		(void)source;
+		((GLDebug*)user)->add(type, id, severity, message, length);
+	}
+}
+
+GLDebug::GLDebug() : m_enabled(false), m_repeatedMessages(0), m_repeatFrames(0) {
+}
+
+bool GLDebug::enable(bool available, int types, Renderer2D::DebugSeverity minimum) {
+	if (!available || glad_glDebugMessageCallback == nullptr || glad_glDebugMessageControl == nullptr) {
+		return false;
+	}
+	glEnable(GL_DEBUG_OUTPUT);
+	// the messages arrive inside the call that caused them and on this thread,
+	// so they need no lock and a breakpoint in add shows the culprit
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDebugMessageCallback(receive, this);
+
+	// filtered by the driver, so the dropped messages never reach the callback
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+	for (int type = 0; type < TYPE_COUNT; ++type) {
+		if ((types & (1 << type)) == 0) {
+			continue;
+		}
+		for (int severity = (int)minimum; severity < SEVERITY_COUNT; ++severity) {
+			glDebugMessageControl(GL_DONT_CARE, TYPES[type], SEVERITIES[severity], 0, nullptr, GL_TRUE);
+		}
+	}
+	m_enabled = true;
+	return true;
+}
+
+void GLDebug::disable() {
+	if (!m_enabled) {
+		return;
+	}
+	glDebugMessageCallback(nullptr, nullptr);
+	glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDisable(GL_DEBUG_OUTPUT);
+	m_enabled = false;
+}
+
+void GLDebug::add(unsigned int type, unsigned int id, unsigned int severity, const char* message, int length) {
+	std::string text = (length >= 0 ? std::string(message, (size_t)length) : std::string(message));
+	// some drivers count the terminating zero into the length
+	while (!text.empty() && (text.back() == '\0' || text.back() == '\n')) {
+		text.pop_back();
+	}
+	std::string key = std::to_string(id) + ":" + text;
+
+	std::unordered_map<std::string, size_t>::iterator it = m_frameMessages.find(key);
+	if (it != m_frameMessages.end()) {
+		++m_messages[it->second].count;
+		return;
+	}
+	Message entry;
+	entry.type = type;
+	entry.id = id;
+	entry.severity = severity;
+	entry.text = text;
+	entry.key = key;
+	entry.count = 1;
+	m_frameMessages.emplace(key, m_messages.size());
+	m_messages.push_back(entry);
+}
+
+void GLDebug::endFrame() {
+	for (size_t i = 0; i < m_messages.size(); ++i) {
+		const Message& message = m_messages[i];
+		if (m_reported.count(message.key) != 0) {
+			m_repeatedMessages += message.count;
+			continue;
+		}
+		if (m_reported.size() >= MAX_REPORTED) {
+			m_reported.clear();
+		}
+		m_reported.insert(message.key);
+		std::cout << "GL_DEBUG::" << typeName(message.type) << "::" << severityName(message.severity)
+			<< " (" << message.count << "x, id " << message.id << ") " << message.text << std::endl;
+	}
+	m_messages.clear();
+	m_frameMessages.clear();
+
+	// messages that come every frame are printed once, then only counted
+	if (++m_repeatFrames >= REPEAT_REPORT_FRAMES) {
+		if (m_repeatedMessages > 0) {
+			std::cout << "GL_DEBUG::REPEATED " << m_repeatedMessages << " messages already shown in the last "
+				<< m_repeatFrames << " frames" << std::endl;
+		}
+		m_repeatedMessages = 0;
+		m_repeatFrames = 0;
+	}
+}
+
+void GLDebug::label(unsigned int identifier, unsigned int name, const char* label) {
+	if (glad_glObjectLabel != nullptr) {
+		glObjectLabel(identifier, name, -1, label);
+	}
+}
+
+GLDebug::~GLDebug() {
+	disable();
+}
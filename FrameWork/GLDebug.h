@@ -0,0 +1,84 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GLDebug.h
+*
+* Description:	Driver messages through KHR_debug. Filters them by type and severity,
+*				collapses repeats into one line per frame with a count, and names
+*				the GL objects of the renderer so the messages point at them.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef GLDEBUG_H_
+#define GLDEBUG_H_
+
+#include "Renderer2D.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class GLDebug {
+public:
+	GLDebug();
+
+	// installs the debug callback and lets the driver drop every other type and severity
+	// @param available - the context has GL 4.3 or KHR_debug
+	// @param types - Renderer2D::DebugType bits
+	// @return false if there is no debug output
+	bool enable(bool available, int types, Renderer2D::DebugSeverity minimum);
+
+	// removes the callback and turns the debug output off
+	void disable();
+
+	bool isEnabled() const { return m_enabled; }
+
+	// counts a message, called from the debug callback
+	void add(unsigned int type, unsigned int id, unsigned int severity, const char* message, int length);
+
+	// prints the messages of the frame, each distinct message once with its count
+	void endFrame();
+
+	// names a GL object in the debug messages, does nothing without KHR_debug
+	// @param identifier - GL_BUFFER, GL_VERTEX_ARRAY, GL_PROGRAM, ...
+	static void label(unsigned int identifier, unsigned int name, const char* label);
+
+	~GLDebug();
+
+protected:
+	enum {
+		// frames between the summaries of messages that were already printed
+		REPEAT_REPORT_FRAMES = 120,
+		// printed messages remembered, beyond this they may be printed again
+		MAX_REPORTED = 1024
+	};
+
+	struct Message {
+		unsigned int type;
+		unsigned int id;
+		unsigned int severity;
+		std::string text;
+		// id and text, what makes two messages the same
+		std::string key;
+		int count;
+	};
+
+	bool m_enabled;
+
+	// distinct messages of the frame, keyed by id and text
+	std::vector<Message> m_messages;
+	std::unordered_map<std::string, size_t> m_frameMessages;
+
+	// messages printed in earlier frames, later repeats are only counted
+	std::unordered_set<std::string> m_reported;
+	int m_repeatedMessages;
+	int m_repeatFrames;
+};
+
+#endif // !GLDEBUG_H_
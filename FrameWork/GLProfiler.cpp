@@ -0,0 +1,290 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GLProfiler.cpp
+*
+* Description:	Optional instrumentation of the GL calls. Wraps the glad function pointers
+*				to count and time every call and prints which calls dominate a frame.
+*				Only built with OPENGLFW_GL_PROFILER, otherwise the macros expand to nothing.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "GLProfiler.h"
+
+#ifdef OPENGLFW_GL_PROFILER
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define GL_PROFILER_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define GL_PROFILER_RDTSC
+#endif
+
+// the profiled functions, every GL call the framework makes plus the common texture
+// and framebuffer calls, calls to other functions are not counted
+#define GL_PROFILER_FUNCTIONS(X) \
+	X(glActiveTexture) \
+	X(glAttachShader) \
+	X(glBindBuffer) \
+	X(glBindFramebuffer) \
+	X(glBindTexture) \
+	X(glBindVertexArray) \
+	X(glBlendFunc) \
+	X(glBufferData) \
+	X(glBufferStorage) \
+	X(glBufferSubData) \
+	X(glClear) \
+	X(glClearColor) \
+	X(glClientWaitSync) \
+	X(glCompileShader) \
+	X(glCompressedTexImage2D) \
+	X(glCompressedTexSubImage2D) \
+	X(glCreateBuffers) \
+	X(glCreateProgram) \
+	X(glCreateShader) \
+	X(glCreateVertexArrays) \
+	X(glDeleteBuffers) \
+	X(glDeleteProgram) \
+	X(glDeleteShader) \
+	X(glDeleteSync) \
+	X(glDeleteTextures) \
+	X(glDeleteVertexArrays) \
+	X(glDepthFunc) \
+	X(glDepthMask) \
+	X(glDisable) \
+	X(glDrawArrays) \
+	X(glDrawArraysInstanced) \
+	X(glDrawArraysInstancedBaseInstance) \
+	X(glDrawElements) \
+	X(glDrawElementsBaseVertex) \
+	X(glEnable) \
+	X(glEnableVertexArrayAttrib) \
+	X(glEnableVertexAttribArray) \
+	X(glFenceSync) \
+	X(glGenBuffers) \
+	X(glGenerateMipmap) \
+	X(glGenTextures) \
+	X(glGenVertexArrays) \
+	X(glGetError) \
+	X(glGetIntegerv) \
+	X(glGetProgramInfoLog) \
+	X(glGetProgramiv) \
+	X(glGetShaderInfoLog) \
+	X(glGetShaderiv) \
+	X(glGetUniformLocation) \
+	X(glInvalidateFramebuffer) \
+	X(glLinkProgram) \
+	X(glMapBufferRange) \
+	X(glMultiDrawElements) \
+	X(glNamedBufferData) \
+	X(glNamedBufferStorage) \
+	X(glNamedBufferSubData) \
+	X(glScissor) \
+	X(glShaderSource) \
+	X(glTexImage2D) \
+	X(glTexParameteri) \
+	X(glTexSubImage2D) \
+	X(glUniform1i) \
+	X(glUniform2f) \
+	X(glUniform4f) \
+	X(glUniformMatrix4fv) \
+	X(glUnmapBuffer) \
+	X(glUseProgram) \
+	X(glVertexArrayAttribBinding) \
+	X(glVertexArrayAttribFormat) \
+	X(glVertexArrayElementBuffer) \
+	X(glVertexArrayVertexBuffer) \
+	X(glVertexAttribDivisor) \
+	X(glVertexAttribPointer) \
+	X(glViewport)
+
+namespace {
+	enum FunctionId {
+#define GL_PROFILER_ID(name) ID_##name,
+		GL_PROFILER_FUNCTIONS(GL_PROFILER_ID)
+#undef GL_PROFILER_ID
+		FUNCTION_COUNT
+	};
+
+	const char* const FUNCTION_NAMES[FUNCTION_COUNT] = {
+#define GL_PROFILER_NAME(name) #name,
+		GL_PROFILER_FUNCTIONS(GL_PROFILER_NAME)
+#undef GL_PROFILER_NAME
+	};
+
+	struct Counter {
+		unsigned long long calls;
+		unsigned long long ticks;
+	};
+
+	// calls of the frames since the last report
+	Counter g_counters[FUNCTION_COUNT];
+	bool g_timing = true;
+	int g_reportInterval = 120;
+	int g_frames = 0;
+
+	// length of the bar of the dominating call in the report
+	const int BAR_WIDTH = 40;
+
+	inline std::uint64_t now() {
+#ifdef GL_PROFILER_RDTSC
+		return __rdtsc();
+#else
+		return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	// counts the call it lives in and times it when timing is on
+	class Scope {
+	public:
+		explicit Scope(int id) : m_id(id), m_timing(g_timing), m_start(m_timing ? now() : 0) {}
+		~Scope() {
+			Counter& counter = g_counters[m_id];
+			++counter.calls;
+			if (m_timing) {
+				counter.ticks += now() - m_start;
+			}
+		}
+
+	private:
+		int m_id;
+		bool m_timing;
+		std::uint64_t m_start;
+	};
+
+	// one wrapper per profiled function, with the same signature as its glad pointer
+	template <int Id, typename Function>
+	struct Hook;
+
+	template <int Id, typename Result, typename... Arguments>
+	struct Hook<Id, Result (APIENTRYP)(Arguments...)> {
+		typedef Result (APIENTRYP Pointer)(Arguments...);
+		static Pointer original;
+
+		static Result APIENTRY call(Arguments... arguments) {
+			Scope scope(Id);
+			return original(arguments...);
+		}
+	};
+
+	template <int Id, typename Result, typename... Arguments>
+	typename Hook<Id, Result (APIENTRYP)(Arguments...)>::Pointer Hook<Id, Result (APIENTRYP)(Arguments...)>::original = nullptr;
+
+	void report() {
+		std::vector<int> called;
+		for (int i = 0; i < FUNCTION_COUNT; ++i) {
+			if (g_counters[i].calls > 0) {
+				called.push_back(i);
+			}
+		}
+		// the most expensive calls first, or the most frequent ones without timing
+		std::sort(called.begin(), called.end(), [](int a, int b) {
+			if (g_timing && g_counters[a].ticks != g_counters[b].ticks) {
+				return g_counters[a].ticks > g_counters[b].ticks;
+			}
+			return g_counters[a].calls > g_counters[b].calls;
+		});
+
+		unsigned long long totalCalls = 0;
+		unsigned long long totalTicks = 0;
+		for (size_t i = 0; i < called.size(); ++i) {
+			totalCalls += g_counters[called[i]].calls;
+			totalTicks += g_counters[called[i]].ticks;
+		}
+#ifdef GL_PROFILER_RDTSC
+		const char* unit = "cycles";
+		double tickScale = 1.0;
+#else
+		const char* unit = "us";
+		double tickScale = 1e-3;
+#endif
+		double frames = (double)g_frames;
+
+		char line[160];
+		std::snprintf(line, sizeof(line), "GL calls per frame, average of %d frames: %.1f calls", g_frames, totalCalls / frames);
+		std::cout << line;
+		if (g_timing) {
+			std::snprintf(line, sizeof(line), ", %.1f %s", totalTicks * tickScale / frames, unit);
+			std::cout << line;
+		}
+		std::cout << std::endl;
+
+		unsigned long long largest = 0;
+		for (size_t i = 0; i < called.size(); ++i) {
+			const Counter& counter = g_counters[called[i]];
+			largest = std::max(largest, g_timing ? counter.ticks : counter.calls);
+		}
+		for (size_t i = 0; i < called.size(); ++i) {
+			const Counter& counter = g_counters[called[i]];
+			unsigned long long value = (g_timing ? counter.ticks : counter.calls);
+			unsigned long long total = (g_timing ? totalTicks : totalCalls);
+			int bar = (largest > 0 ? (int)((value * BAR_WIDTH + largest - 1) / largest) : 0);
+			double share = (total > 0 ? 100.0 * value / total : 0.0);
+			if (g_timing) {
+				std::snprintf(line, sizeof(line), "  %-36s %10.1f calls %12.1f %-6s %5.1f%% ",
+					FUNCTION_NAMES[called[i]], counter.calls / frames, counter.ticks * tickScale / frames, unit, share);
+			}
+			else {
+				std::snprintf(line, sizeof(line), "  %-36s %10.1f calls %5.1f%% ",
+					FUNCTION_NAMES[called[i]], counter.calls / frames, share);
+			}
+			std::cout << line << std::string(bar, '#') << std::endl;
+		}
+	}
+}
+
+void GLProfiler::install() {
+#define GL_PROFILER_HOOK(name) \
+	if (glad_##name != nullptr && glad_##name != Hook<ID_##name, decltype(glad_##name)>::call) { \
+		Hook<ID_##name, decltype(glad_##name)>::original = glad_##name; \
+		glad_##name = Hook<ID_##name, decltype(glad_##name)>::call; \
+	}
+	GL_PROFILER_FUNCTIONS(GL_PROFILER_HOOK)
+#undef GL_PROFILER_HOOK
+}
+
+void GLProfiler::uninstall() {
+#define GL_PROFILER_UNHOOK(name) \
+	if (glad_##name == Hook<ID_##name, decltype(glad_##name)>::call) { \
+		glad_##name = Hook<ID_##name, decltype(glad_##name)>::original; \
+	}
+	GL_PROFILER_FUNCTIONS(GL_PROFILER_UNHOOK)
+#undef GL_PROFILER_UNHOOK
+}
+
+void GLProfiler::setTiming(bool timing) {
+	g_timing = timing;
+}
+
+void GLProfiler::setReportInterval(int frames) {
+	g_reportInterval = std::max(frames, 0);
+}
+
+void GLProfiler::endFrame() {
+	++g_frames;
+	if (g_reportInterval == 0 || g_frames < g_reportInterval) {
+		return;
+	}
+	report();
+	std::fill(g_counters, g_counters + FUNCTION_COUNT, Counter());
+	g_frames = 0;
+}
+
+#endif // OPENGLFW_GL_PROFILER
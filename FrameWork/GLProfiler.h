@@ -0,0 +1,52 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GLProfiler.h
+*
+* Description:	Optional instrumentation of the GL calls. Wraps the glad function pointers
+*				to count and time every call and prints which calls dominate a frame.
+*				Only built with OPENGLFW_GL_PROFILER, otherwise the macros expand to nothing.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef GLPROFILER_H_
+#define GLPROFILER_H_
+
+#ifdef OPENGLFW_GL_PROFILER
+
+namespace GLProfiler {
+	// swaps the glad pointers of the profiled functions for counting wrappers,
+	// call again after loading more pointers, already wrapped ones are skipped
+	void install();
+
+	// puts the original pointers back
+	void uninstall();
+
+	// times the calls besides counting them, with rdtsc on x86 and steady_clock elsewhere,
+	// only the time spent in the driver call is measured, not the GPU time
+	void setTiming(bool timing);
+
+	// number of frames averaged into each report, 0 stops the reports
+	void setReportInterval(int frames);
+
+	// closes the current frame, prints the report once the interval is reached
+	void endFrame();
+}
+
+#define GL_PROFILER_INSTALL() GLProfiler::install()
+#define GL_PROFILER_END_FRAME() GLProfiler::endFrame()
+
+#else
+
+#define GL_PROFILER_INSTALL() ((void)0)
+#define GL_PROFILER_END_FRAME() ((void)0)
+
+#endif // OPENGLFW_GL_PROFILER
+
+#endif // !GLPROFILER_H_
@@ -0,0 +1,505 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GlyphCache.cpp
+*
+* Description:	Fonts, the glyph atlas and the text layout cache of the renderer.
+*				Glyphs are stored as signed distance fields in fixed size cells of one
+*				texture and replaced least recently used first, layouts are cached per string.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "GlyphCache.h"
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// squared distance standing in for no feature pixel at all
+	const float FAR_DISTANCE = 1e20f;
+
+	const unsigned int REPLACEMENT_CHARACTER = 0xFFFD;
+
+	// the built-in font, 8 rows of 8 pixels per character from ' ' to '~',
+	// bit 0 is the leftmost pixel and row 7 holds the descenders
+	const int BUILTIN_EM = 8;
+	const int BUILTIN_BASELINE = 7;
+	const unsigned char BUILTIN_FONT[95][8] = {
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // space
+		{ 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00 }, // !
+		{ 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // "
+		{ 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00 }, // #
+		{ 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00 }, // $
+		{ 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00 }, // %
+		{ 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00 }, // &
+		{ 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '
+		{ 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00 }, // (
+		{ 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00 }, // )
+		{ 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 }, // *
+		{ 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00 }, // +
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06 }, // ,
+		{ 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00 }, // -
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 }, // .
+		{ 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00 }, // /
+		{ 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00 }, // 0
+		{ 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00 }, // 1
+		{ 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00 }, // 2
+		{ 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00 }, // 3
+		{ 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00 }, // 4
+		{ 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00 }, // 5
+		{ 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00 }, // 6
+		{ 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00 }, // 7
+		{ 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00 }, // 8
+		{ 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00 }, // 9
+		{ 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00 }, // :
+		{ 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06 }, // ;
+		{ 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00 }, // <
+		{ 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00 }, // =
+		{ 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00 }, // >
+		{ 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00 }, // ?
+		{ 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00 }, // @
+		{ 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00 }, // A
+		{ 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00 }, // B
+		{ 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00 }, // C
+		{ 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00 }, // D
+		{ 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00 }, // E
+		{ 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00 }, // F
+		{ 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00 }, // G
+		{ 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00 }, // H
+		{ 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // I
+		{ 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00 }, // J
+		{ 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00 }, // K
+		{ 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00 }, // L
+		{ 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00 }, // M
+		{ 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00 }, // N
+		{ 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00 }, // O
+		{ 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00 }, // P
+		{ 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00 }, // Q
+		{ 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00 }, // R
+		{ 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00 }, // S
+		{ 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // T
+		{ 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00 }, // U
+		{ 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 }, // V
+		{ 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00 }, // W
+		{ 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00 }, // X
+		{ 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00 }, // Y
+		{ 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00 }, // Z
+		{ 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00 }, // [
+		{ 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00 }, // backslash
+		{ 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00 }, // ]
+		{ 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00 }, // ^
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF }, // _
+		{ 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 }, // `
+		{ 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00 }, // a
+		{ 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00 }, // b
+		{ 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00 }, // c
+		{ 0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00 }, // d
+		{ 0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00 }, // e
+		{ 0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00 }, // f
+		{ 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F }, // g
+		{ 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00 }, // h
+		{ 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // i
+		{ 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E }, // j
+		{ 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00 }, // k
+		{ 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // l
+		{ 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00 }, // m
+		{ 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00 }, // n
+		{ 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00 }, // o
+		{ 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F }, // p
+		{ 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78 }, // q
+		{ 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00 }, // r
+		{ 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00 }, // s
+		{ 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00 }, // t
+		{ 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00 }, // u
+		{ 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 }, // v
+		{ 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00 }, // w
+		{ 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00 }, // x
+		{ 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F }, // y
+		{ 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00 }, // z
+		{ 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00 }, // {
+		{ 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00 }, // |
+		{ 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00 }, // }
+		{ 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ~
+	};
+
+	bool rasterizeBuiltin(void* user, unsigned int codepoint, int pixelsPerEm, Renderer2D::Glyph& glyph) {
+		std::vector<unsigned char>& pixels = *(std::vector<unsigned char>*)user;
+		if (codepoint < 32 || codepoint > 126) {
+			codepoint = '?';
+		}
+		const unsigned char* rows = BUILTIN_FONT[codepoint - 32];
+
+		// every font pixel becomes a block of scale by scale pixels
+		int scale = std::max(pixelsPerEm / BUILTIN_EM, 1);
+		int size = BUILTIN_EM * scale;
+		pixels.assign((size_t)size * size, 0);
+		bool empty = true;
+		for (int y = 0; y < BUILTIN_EM; ++y) {
+			for (int x = 0; x < BUILTIN_EM; ++x) {
+				if (((rows[y] >> x) & 1) == 0) {
+					continue;
+				}
+				empty = false;
+				for (int row = y * scale; row < (y + 1) * scale; ++row) {
+					std::fill(pixels.begin() + row * size + x * scale, pixels.begin() + row * size + (x + 1) * scale, (unsigned char)255);
+				}
+			}
+		}
+		glyph.pixels = pixels.data();
+		glyph.width = (empty ? 0 : size);
+		glyph.height = (empty ? 0 : size);
+		glyph.left = 0;
+		glyph.top = BUILTIN_BASELINE * scale;
+		return true;
+	}
+
+	float advanceBuiltin(void* user, unsigned int codepoint, unsigned int next) {
+		(void)user;
+		(void)codepoint;
+		(void)next;
+		return 1.0f;
+	}
+
+	inline unsigned long long glyphKey(FontHandle font, unsigned int codepoint) {
+		return ((unsigned long long)font << 32) | codepoint;
+	}
+
+	// reads one UTF-8 character and moves text past it, broken sequences give U+FFFD
+	unsigned int decode(const unsigned char*& text) {
+		unsigned int lead = *text++;
+		if (lead < 0x80) {
+			return lead;
+		}
+		int extra = (lead >= 0xF8 ? -1 : lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1);
+		if (extra < 0) {
+			return REPLACEMENT_CHARACTER;
+		}
+		unsigned int codepoint = lead & (0x3Fu >> extra);
+		for (int i = 0; i < extra; ++i) {
+			if ((*text & 0xC0) != 0x80) {
+				return REPLACEMENT_CHARACTER;
+			}
+			codepoint = (codepoint << 6) | (*text++ & 0x3F);
+		}
+		return codepoint;
+	}
+
+	/**
+		Squared euclidean distance transform of one row, Felzenszwalb and Huttenlocher.
+		@param f - squared distance of each pixel to a feature along the other axis, FAR_DISTANCE for none
+		@param d - result, squared distance to the nearest feature
+		@param v, z - scratch space of n and n + 1 elements for the lower envelope of the parabolas
+	*/
+	void transform1D(const float* f, float* d, int n, int* v, float* z) {
+		int k = 0;
+		v[0] = 0;
+		z[0] = -FAR_DISTANCE;
+		z[1] = FAR_DISTANCE;
+		for (int q = 1; q < n; ++q) {
+			float s = ((f[q] + (float)(q * q)) - (f[v[k]] + (float)(v[k] * v[k]))) / (float)(2 * q - 2 * v[k]);
+			while (s <= z[k]) {
+				--k;
+				s = ((f[q] + (float)(q * q)) - (f[v[k]] + (float)(v[k] * v[k]))) / (float)(2 * q - 2 * v[k]);
+			}
+			++k;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = FAR_DISTANCE;
+		}
+		k = 0;
+		for (int q = 0; q < n; ++q) {
+			while (z[k + 1] < (float)q) {
+				++k;
+			}
+			d[q] = (float)((q - v[k]) * (q - v[k])) + f[v[k]];
+		}
+	}
+
+	// transforms the columns and then the rows of a width by height image in place
+	void transform2D(std::vector<float>& image, int width, int height,
+		std::vector<float>& line, std::vector<float>& distance, std::vector<int>& v, std::vector<float>& z) {
+		int size = std::max(width, height);
+		line.resize(size);
+		distance.resize(size);
+		v.resize(size);
+		z.resize(size + 1);
+		for (int x = 0; x < width; ++x) {
+			for (int y = 0; y < height; ++y) {
+				line[y] = image[y * width + x];
+			}
+			transform1D(line.data(), distance.data(), height, v.data(), z.data());
+			for (int y = 0; y < height; ++y) {
+				image[y * width + x] = distance[y];
+			}
+		}
+		for (int y = 0; y < height; ++y) {
+			transform1D(&image[y * width], distance.data(), width, v.data(), z.data());
+			std::copy(distance.begin(), distance.begin() + width, image.begin() + y * width);
+		}
+	}
+}
+
+GlyphCache::GlyphCache() {
+	m_cells.resize(CELL_COUNT);
+	for (int i = CELL_COUNT - 1; i >= 0; --i) {
+		m_freeCells.push_back(i);
+	}
+
+	// the atlas starts out empty, glyphs are written into it as they are first drawn
+	std::vector<unsigned char> empty((size_t)ATLAS_SIZE * ATLAS_SIZE, 0);
+	glGenTextures(1, &m_texture);
+	glBindTexture(GL_TEXTURE_2D, m_texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	GLDebug::label(GL_TEXTURE, m_texture, "GlyphCache atlas");
+
+	Renderer2D::FontSource builtin;
+	builtin.user = &m_builtinPixels;
+	builtin.ascent = (float)BUILTIN_BASELINE / BUILTIN_EM;
+	builtin.descent = (float)(BUILTIN_EM - BUILTIN_BASELINE) / BUILTIN_EM;
+	builtin.lineGap = 1.0f / BUILTIN_EM;
+	builtin.rasterize = rasterizeBuiltin;
+	builtin.advance = advanceBuiltin;
+	m_builtinFont = createFont(builtin);
+}
+
+FontHandle GlyphCache::createFont(const Renderer2D::FontSource& source) {
+	// handles are never reused, so cached layouts of a destroyed font are never hit again
+	Font font = { source, true };
+	m_fonts.push_back(font);
+	return (FontHandle)m_fonts.size();
+}
+
+void GlyphCache::destroyFont(FontHandle font) {
+	if (!isFont(font) || font == m_builtinFont) {
+		return;
+	}
+	m_fonts[font - 1].alive = false;
+
+	std::unordered_map<unsigned long long, Entry>::iterator it = m_entries.begin();
+	while (it != m_entries.end()) {
+		if ((FontHandle)(it->first >> 32) != font) {
+			++it;
+			continue;
+		}
+		int cell = it->second.cell;
+		if (cell >= 0) {
+			m_lru.erase(m_cells[cell].position);
+			m_freeCells.push_back(cell);
+		}
+		it = m_entries.erase(it);
+	}
+}
+
+bool GlyphCache::isFont(FontHandle font) const {
+	return font != 0 && font <= m_fonts.size() && m_fonts[font - 1].alive;
+}
+
+const GlyphCache::Layout& GlyphCache::layout(FontHandle font, const char* text, unsigned int frame) {
+	// FNV-1a over the font and the bytes of the string
+	unsigned long long hash = 14695981039346656037ull;
+	for (int i = 0; i < 4; ++i) {
+		hash = (hash ^ ((font >> (i * 8)) & 0xFF)) * 1099511628211ull;
+	}
+	for (const unsigned char* c = (const unsigned char*)text; *c != 0; ++c) {
+		hash = (hash ^ *c) * 1099511628211ull;
+	}
+
+	// the hash alone could hand out the glyphs of another string, so the key is compared too
+	std::unordered_map<unsigned long long, Layout>::iterator it = m_layouts.find(hash);
+	if (it != m_layouts.end() && it->second.font == font && it->second.text == text) {
+		it->second.lastFrame = frame;
+		return it->second;
+	}
+
+	Layout& layout = m_layouts[hash];
+	layout.font = font;
+	layout.text = text;
+	layout.glyphs.clear();
+	layout.lastFrame = frame;
+	const Renderer2D::FontSource& source = m_fonts[font - 1].source;
+
+	std::vector<unsigned int> codepoints;
+	for (const unsigned char* c = (const unsigned char*)text; *c != 0;) {
+		codepoints.push_back(decode(c));
+	}
+
+	float lineHeight = source.ascent + source.descent + source.lineGap;
+	float x = 0.0f;
+	float y = 0.0f;
+	float width = 0.0f;
+	for (size_t i = 0; i < codepoints.size(); ++i) {
+		unsigned int codepoint = codepoints[i];
+		if (codepoint == '\n') {
+			width = std::max(width, x);
+			x = 0.0f;
+			y -= lineHeight;
+			continue;
+		}
+		unsigned int next = (i + 1 < codepoints.size() && codepoints[i + 1] != '\n' ? codepoints[i + 1] : 0);
+		if (codepoint != ' ') {
+			PlacedGlyph glyph = { codepoint, x, y };
+			layout.glyphs.push_back(glyph);
+		}
+		x += source.advance(source.user, codepoint, next);
+	}
+	width = std::max(width, x);
+	layout.bounds[0] = 0.0f;
+	layout.bounds[1] = y - source.descent;
+	layout.bounds[2] = width;
+	layout.bounds[3] = source.ascent;
+	return layout;
+}
+
+const GlyphCache::Entry* GlyphCache::find(FontHandle font, unsigned int codepoint, unsigned int frame) {
+	std::unordered_map<unsigned long long, Entry>::iterator it = m_entries.find(glyphKey(font, codepoint));
+	if (it == m_entries.end()) {
+		return nullptr;
+	}
+	int cell = it->second.cell;
+	// the order is kept per frame, which is all the replacement needs
+	if (cell >= 0 && m_cells[cell].lastFrame != frame) {
+		m_lru.splice(m_lru.begin(), m_lru, m_cells[cell].position);
+		m_cells[cell].lastFrame = frame;
+	}
+	return &it->second;
+}
+
+bool GlyphCache::isFull(unsigned int frame) const {
+	return m_freeCells.empty() && !m_lru.empty() && m_cells[m_lru.back()].lastFrame == frame;
+}
+
+const GlyphCache::Entry& GlyphCache::load(FontHandle font, unsigned int codepoint, unsigned int frame) {
+	unsigned long long key = glyphKey(font, codepoint);
+	Entry entry;
+	entry.cell = -1;
+	std::fill(entry.quad, entry.quad + 4, 0.0f);
+	std::fill(entry.uv, entry.uv + 4, 0.0f);
+
+	const Renderer2D::FontSource& source = m_fonts[font - 1].source;
+	Renderer2D::Glyph glyph = {};
+	if (!source.rasterize(source.user, codepoint, RASTER_EM, glyph) || glyph.pixels == nullptr || glyph.width <= 0 || glyph.height <= 0) {
+		// missing glyphs and glyphs without pixels only take a map entry
+		return m_entries[key] = entry;
+	}
+
+	// a free cell, or the one used longest ago
+	int cell;
+	if (!m_freeCells.empty()) {
+		cell = m_freeCells.back();
+		m_freeCells.pop_back();
+		m_lru.push_front(cell);
+		m_cells[cell].position = m_lru.begin();
+	}
+	else {
+		cell = m_lru.back();
+		m_entries.erase(m_cells[cell].key);
+		m_lru.splice(m_lru.begin(), m_lru, m_cells[cell].position);
+	}
+	m_cells[cell].key = key;
+	m_cells[cell].lastFrame = frame;
+
+	int width, height;
+	buildDistanceField(glyph, width, height);
+
+	// the whole cell is written, so nothing of the glyph it held before is sampled at the edges
+	int cellX = (cell % CELLS_PER_ROW) * CELL_SIZE;
+	int cellY = (cell / CELLS_PER_ROW) * CELL_SIZE;
+	glBindTexture(GL_TEXTURE_2D, m_texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, cellX, cellY, CELL_SIZE, CELL_SIZE, GL_RED, GL_UNSIGNED_BYTE, m_cellPixels.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// the field reaches SDF_SPREAD atlas pixels past the glyph on every side,
+	// its first row is the top one and sits at the lower atlas coordinate
+	float pad = (float)(SDF_SPREAD * SDF_DOWNSAMPLE);
+	entry.cell = cell;
+	entry.quad[0] = ((float)glyph.left - pad) / RASTER_EM;
+	entry.quad[3] = ((float)glyph.top + pad) / RASTER_EM;
+	entry.quad[2] = entry.quad[0] + (float)(width * SDF_DOWNSAMPLE) / RASTER_EM;
+	entry.quad[1] = entry.quad[3] - (float)(height * SDF_DOWNSAMPLE) / RASTER_EM;
+	entry.uv[0] = (float)cellX / ATLAS_SIZE;
+	entry.uv[1] = (float)(cellY + height) / ATLAS_SIZE;
+	entry.uv[2] = (float)(cellX + width) / ATLAS_SIZE;
+	entry.uv[3] = (float)cellY / ATLAS_SIZE;
+	return m_entries[key] = entry;
+}
+
+void GlyphCache::buildDistanceField(const Renderer2D::Glyph& glyph, int& width, int& height) {
+	// glyphs larger than a cell are cut off
+	int pad = SDF_SPREAD * SDF_DOWNSAMPLE;
+	int maxSize = CELL_SIZE * SDF_DOWNSAMPLE - 2 * pad;
+	int glyphWidth = std::min(glyph.width, maxSize);
+	int glyphHeight = std::min(glyph.height, maxSize);
+	int fieldWidth = (glyphWidth + 2 * pad + SDF_DOWNSAMPLE - 1) / SDF_DOWNSAMPLE * SDF_DOWNSAMPLE;
+	int fieldHeight = (glyphHeight + 2 * pad + SDF_DOWNSAMPLE - 1) / SDF_DOWNSAMPLE * SDF_DOWNSAMPLE;
+
+	// squared distances to the nearest pixel inside and outside the glyph
+	size_t count = (size_t)fieldWidth * fieldHeight;
+	m_inside.resize(count);
+	m_outside.resize(count);
+	for (int y = 0; y < fieldHeight; ++y) {
+		for (int x = 0; x < fieldWidth; ++x) {
+			int gx = x - pad;
+			int gy = y - pad;
+			bool inside = gx >= 0 && gy >= 0 && gx < glyphWidth && gy < glyphHeight && glyph.pixels[gy * glyph.width + gx] >= 128;
+			m_inside[y * fieldWidth + x] = (inside ? 0.0f : FAR_DISTANCE);
+			m_outside[y * fieldWidth + x] = (inside ? FAR_DISTANCE : 0.0f);
+		}
+	}
+	transform2D(m_inside, fieldWidth, fieldHeight, m_row, m_rowDistance, m_parabolas, m_parabolaRanges);
+	transform2D(m_outside, fieldWidth, fieldHeight, m_row, m_rowDistance, m_parabolas, m_parabolaRanges);
+
+	// signed distance to the outline, positive inside, averaged over each block of
+	// SDF_DOWNSAMPLE pixels and stored with the outline at 128
+	width = fieldWidth / SDF_DOWNSAMPLE;
+	height = fieldHeight / SDF_DOWNSAMPLE;
+	m_cellPixels.assign((size_t)CELL_SIZE * CELL_SIZE, 0);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			float sum = 0.0f;
+			for (int dy = 0; dy < SDF_DOWNSAMPLE; ++dy) {
+				for (int dx = 0; dx < SDF_DOWNSAMPLE; ++dx) {
+					size_t i = (size_t)(y * SDF_DOWNSAMPLE + dy) * fieldWidth + (x * SDF_DOWNSAMPLE + dx);
+					// pixel centers are half a pixel away from the outline between them
+					sum += (m_inside[i] == 0.0f ? std::sqrt(m_outside[i]) - 0.5f : 0.5f - std::sqrt(m_inside[i]));
+				}
+			}
+			float distance = sum / (float)(SDF_DOWNSAMPLE * SDF_DOWNSAMPLE * SDF_DOWNSAMPLE);
+			float value = 128.0f + distance * (127.0f / SDF_SPREAD);
+			m_cellPixels[y * CELL_SIZE + x] = (unsigned char)std::min(std::max(value + 0.5f, 0.0f), 255.0f);
+		}
+	}
+}
+
+void GlyphCache::trim(unsigned int frame) {
+	if (frame % LAYOUT_CACHE_FRAMES != 0) {
+		return;
+	}
+	std::unordered_map<unsigned long long, Layout>::iterator it = m_layouts.begin();
+	while (it != m_layouts.end()) {
+		if (frame - it->second.lastFrame > LAYOUT_CACHE_FRAMES) {
+			it = m_layouts.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+GlyphCache::~GlyphCache() {
+	glDeleteTextures(1, &m_texture);
+}
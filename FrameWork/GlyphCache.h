@@ -0,0 +1,137 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: GlyphCache.h
+*
+* Description:	Fonts, the glyph atlas and the text layout cache of the renderer.
+*				Glyphs are stored as signed distance fields in fixed size cells of one
+*				texture and replaced least recently used first, layouts are cached per string.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef GLYPHCACHE_H_
+#define GLYPHCACHE_H_
+
+#include "Renderer2D.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class GlyphCache {
+public:
+	enum {
+		// single channel atlas of CELL_COUNT cells
+		ATLAS_SIZE = 1024,
+		CELL_SIZE = 48,
+		CELLS_PER_ROW = ATLAS_SIZE / CELL_SIZE,
+		CELL_COUNT = CELLS_PER_ROW * CELLS_PER_ROW,
+		// glyphs are rasterized at RASTER_EM pixels per em and their distance field
+		// is stored at 1 / SDF_DOWNSAMPLE of that, reaching SDF_SPREAD atlas pixels out
+		RASTER_EM = 64,
+		SDF_DOWNSAMPLE = 2,
+		SDF_SPREAD = 4,
+		// layouts not drawn for this many frames are dropped
+		LAYOUT_CACHE_FRAMES = 120
+	};
+
+	// glyph in the atlas
+	struct Entry {
+		// atlas cell, -1 for glyphs without pixels such as spaces
+		int cell;
+		// quad relative to the pen position in em, left, bottom, right, top
+		float quad[4];
+		// atlas coordinates of the bottom left and top right corner
+		float uv[4];
+	};
+
+	// glyph of a laid out string at its pen position in em
+	struct PlacedGlyph {
+		unsigned int codepoint;
+		float x, y;
+	};
+
+	struct Layout {
+		// the key the layout was made for, compared on a hit since the map only keys the hash
+		FontHandle font;
+		std::string text;
+		std::vector<PlacedGlyph> glyphs;
+		// box of the lines in em, min x, min y, max x, max y
+		float bounds[4];
+		unsigned int lastFrame;
+	};
+
+	GlyphCache();
+
+	FontHandle createFont(const Renderer2D::FontSource& source);
+	void destroyFont(FontHandle font);
+	bool isFont(FontHandle font) const;
+	FontHandle getBuiltinFont() const { return m_builtinFont; }
+
+	// lays out UTF-8 text, strings laid out before come from the cache
+	const Layout& layout(FontHandle font, const char* text, unsigned int frame);
+
+	// glyph already in the atlas, marked as used in frame
+	// @return nullptr if the glyph has to be loaded
+	const Entry* find(FontHandle font, unsigned int codepoint, unsigned int frame);
+
+	// true if loading another glyph would replace one used in frame,
+	// the text queued so far has to be drawn first
+	bool isFull(unsigned int frame) const;
+
+	// rasterizes a glyph into the least recently used cell
+	const Entry& load(FontHandle font, unsigned int codepoint, unsigned int frame);
+
+	// drops the layouts that were not used for LAYOUT_CACHE_FRAMES frames
+	void trim(unsigned int frame);
+
+	unsigned int getTexture() const { return m_texture; }
+
+	~GlyphCache();
+
+protected:
+	struct Font {
+		Renderer2D::FontSource source;
+		bool alive;
+	};
+
+	struct Cell {
+		// key of the glyph in the cell
+		unsigned long long key;
+		unsigned int lastFrame;
+		std::list<int>::iterator position;
+	};
+
+	// writes the signed distance field of a coverage bitmap into m_cellPixels
+	// @param width, height - size of the field in atlas pixels
+	void buildDistanceField(const Renderer2D::Glyph& glyph, int& width, int& height);
+
+	unsigned int m_texture;
+
+	std::vector<Font> m_fonts;
+	FontHandle m_builtinFont;
+
+	std::vector<Cell> m_cells;
+	// occupied cells, most recently used first
+	std::list<int> m_lru;
+	std::vector<int> m_freeCells;
+	std::unordered_map<unsigned long long, Entry> m_entries;
+
+	// layouts keyed by a hash of the font and the string, two strings with the same hash
+	// share the entry and the later one replaces the earlier
+	std::unordered_map<unsigned long long, Layout> m_layouts;
+
+	// scratch space of the distance field, kept to avoid allocating per glyph
+	std::vector<unsigned char> m_builtinPixels;
+	std::vector<float> m_inside, m_outside, m_row, m_rowDistance, m_parabolaRanges;
+	std::vector<int> m_parabolas;
+	std::vector<unsigned char> m_cellPixels;
+};
+
+#endif // !GLYPHCACHE_H_
@@ -0,0 +1,229 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Input.cpp
+*
+* Description:	Buffered keyboard and mouse input.
+*				GLFW callbacks push timestamped events into a preallocated lock-free ring buffer,
+*				which is drained once per frame into key and mouse button snapshots.
+*				Window sizes bypass the ring through atomic fields, so a full queue cannot lose them,
+*				and the size is known without querying GLFW, the resize events are still queued.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Input.h"
+#include <GLFW/glfw3.h>
+
+Input::Input() : m_window(nullptr), m_head(0), m_tail(0), m_droppedEvents(0), m_frameEventCount(0),
+	m_mouseX(0.0f), m_mouseY(0.0f), m_scrollX(0.0f), m_scrollY(0.0f),
+	m_framebufferWidth(0), m_framebufferHeight(0), m_windowWidth(0), m_windowHeight(0),
+	m_contentScaleX(1.0f), m_contentScaleY(1.0f), m_resized(false),
+	m_pendingFramebufferWidth(0), m_pendingFramebufferHeight(0), m_pendingWindowWidth(0), m_pendingWindowHeight(0),
+	m_resizePending(false) {
+}
+
+/**
+	Installs the input callbacks on the window
+
+	@param window - window whose events are buffered, its user pointer is set to this object
+*/
+void Input::attach(GLFWwindow* window) {
+	m_window = window;
+	glfwSetWindowUserPointer(window, this);
+	glfwSetKeyCallback(window, keyCallback);
+	glfwSetMouseButtonCallback(window, mouseButtonCallback);
+	glfwSetCursorPosCallback(window, cursorPosCallback);
+	glfwSetScrollCallback(window, scrollCallback);
+	glfwSetCharCallback(window, charCallback);
+	glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+	glfwSetWindowSizeCallback(window, windowSizeCallback);
+
+	// start from the current cursor position rather than the origin
+	double x = 0.0;
+	double y = 0.0;
+	glfwGetCursorPos(window, &x, &y);
+	m_mouseX = (float)x;
+	m_mouseY = (float)y;
+
+	// the sizes are queried once here, afterwards they only change through the size callbacks
+	glfwGetFramebufferSize(window, &m_framebufferWidth, &m_framebufferHeight);
+	glfwGetWindowSize(window, &m_windowWidth, &m_windowHeight);
+	m_pendingFramebufferWidth.store(m_framebufferWidth, std::memory_order_relaxed);
+	m_pendingFramebufferHeight.store(m_framebufferHeight, std::memory_order_relaxed);
+	m_pendingWindowWidth.store(m_windowWidth, std::memory_order_relaxed);
+	m_pendingWindowHeight.store(m_windowHeight, std::memory_order_relaxed);
+	updateContentScale();
+}
+
+void Input::push(EventType type, int code, int action, int mods, float x, float y) {
+	unsigned int head = m_head.load(std::memory_order_relaxed);
+	unsigned int tail = m_tail.load(std::memory_order_acquire);
+	// the queue is full, drop the event rather than block the callback
+	if (head - tail >= QUEUE_SIZE) {
+		m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Event& e = m_queue[head & (QUEUE_SIZE - 1)];
+	e.type = type;
+	e.time = glfwGetTime();
+	e.code = code;
+	e.action = action;
+	e.mods = mods;
+	e.x = x;
+	e.y = y;
+
+	// publish the event to the consumer
+	m_head.store(head + 1, std::memory_order_release);
+}
+
+void Input::update() {
+	m_keysPressed.reset();
+	m_keysReleased.reset();
+	m_buttonsPressed.reset();
+	m_buttonsReleased.reset();
+	m_scrollX = 0.0f;
+	m_scrollY = 0.0f;
+	m_frameEventCount = 0;
+	m_resized = false;
+
+	unsigned int tail = m_tail.load(std::memory_order_relaxed);
+	unsigned int head = m_head.load(std::memory_order_acquire);
+
+	for (; tail != head; ++tail) {
+		const Event& e = m_queue[tail & (QUEUE_SIZE - 1)];
+		m_frameEvents[m_frameEventCount++] = e;
+
+		switch (e.type) {
+		case KEY_EVENT:
+			if (e.code < 0 || e.code >= MAX_KEYS) {
+				break;
+			}
+			if (e.action == GLFW_PRESS) {
+				m_keys.set(e.code);
+				m_keysPressed.set(e.code);
+			}
+			else if (e.action == GLFW_RELEASE) {
+				m_keys.reset(e.code);
+				m_keysReleased.set(e.code);
+			}
+			break;
+		case MOUSE_BUTTON_EVENT:
+			if (e.code < 0 || e.code >= MAX_BUTTONS) {
+				break;
+			}
+			if (e.action == GLFW_PRESS) {
+				m_buttons.set(e.code);
+				m_buttonsPressed.set(e.code);
+			}
+			else {
+				m_buttons.reset(e.code);
+				m_buttonsReleased.set(e.code);
+			}
+			break;
+		case MOUSE_MOVE_EVENT:
+			m_mouseX = e.x;
+			m_mouseY = e.y;
+			break;
+		case SCROLL_EVENT:
+			m_scrollX += e.x;
+			m_scrollY += e.y;
+			break;
+		default:
+			break;
+		}
+	}
+
+	// hand the slots back to the producer
+	m_tail.store(tail, std::memory_order_release);
+
+	// the sizes bypass the ring, so a full queue cannot lose the last resize
+	if (m_resizePending.exchange(false, std::memory_order_acquire)) {
+		m_framebufferWidth = m_pendingFramebufferWidth.load(std::memory_order_relaxed);
+		m_framebufferHeight = m_pendingFramebufferHeight.load(std::memory_order_relaxed);
+		m_windowWidth = m_pendingWindowWidth.load(std::memory_order_relaxed);
+		m_windowHeight = m_pendingWindowHeight.load(std::memory_order_relaxed);
+		updateContentScale();
+		m_resized = true;
+	}
+}
+
+void Input::updateContentScale() {
+	// a minimized window has no size, keep the last scale
+	if (m_windowWidth > 0 && m_windowHeight > 0 && m_framebufferWidth > 0 && m_framebufferHeight > 0) {
+		m_contentScaleX = (float)m_framebufferWidth / (float)m_windowWidth;
+		m_contentScaleY = (float)m_framebufferHeight / (float)m_windowHeight;
+	}
+}
+
+bool Input::isKeyDown(int key) const {
+	return key >= 0 && key < MAX_KEYS && m_keys.test(key);
+}
+
+bool Input::wasKeyPressed(int key) const {
+	return key >= 0 && key < MAX_KEYS && m_keysPressed.test(key);
+}
+
+bool Input::wasKeyReleased(int key) const {
+	return key >= 0 && key < MAX_KEYS && m_keysReleased.test(key);
+}
+
+bool Input::isMouseButtonDown(int button) const {
+	return button >= 0 && button < MAX_BUTTONS && m_buttons.test(button);
+}
+
+bool Input::wasMouseButtonPressed(int button) const {
+	return button >= 0 && button < MAX_BUTTONS && m_buttonsPressed.test(button);
+}
+
+bool Input::wasMouseButtonReleased(int button) const {
+	return button >= 0 && button < MAX_BUTTONS && m_buttonsReleased.test(button);
+}
+
+void Input::keyCallback(GLFWwindow* window, int key, int, int action, int mods) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->push(KEY_EVENT, key, action, mods, 0.0f, 0.0f);
+}
+
+void Input::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->push(MOUSE_BUTTON_EVENT, button, action, mods, 0.0f, 0.0f);
+}
+
+void Input::cursorPosCallback(GLFWwindow* window, double x, double y) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->push(MOUSE_MOVE_EVENT, 0, 0, 0, (float)x, (float)y);
+}
+
+void Input::scrollCallback(GLFWwindow* window, double x, double y) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->push(SCROLL_EVENT, 0, 0, 0, (float)x, (float)y);
+}
+
+void Input::charCallback(GLFWwindow* window, unsigned int codepoint) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->push(CHAR_EVENT, (int)codepoint, 0, 0, 0.0f, 0.0f);
+}
+
+void Input::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->m_pendingFramebufferWidth.store(width, std::memory_order_relaxed);
+	input->m_pendingFramebufferHeight.store(height, std::memory_order_relaxed);
+	input->m_resizePending.store(true, std::memory_order_release);
+	// the event is still queued for listeners, dropping it no longer loses the size
+	input->push(FRAMEBUFFER_SIZE_EVENT, 0, 0, 0, (float)width, (float)height);
+}
+
+void Input::windowSizeCallback(GLFWwindow* window, int width, int height) {
+	Input* input = static_cast<Input*>(glfwGetWindowUserPointer(window));
+	input->m_pendingWindowWidth.store(width, std::memory_order_relaxed);
+	input->m_pendingWindowHeight.store(height, std::memory_order_relaxed);
+	input->m_resizePending.store(true, std::memory_order_release);
+	input->push(WINDOW_SIZE_EVENT, 0, 0, 0, (float)width, (float)height);
+}
@@ -0,0 +1,151 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Input.h
+*
+* Description:	Buffered keyboard and mouse input.
+*				GLFW callbacks push timestamped events into a preallocated lock-free ring buffer,
+*				which is drained once per frame into key and mouse button snapshots.
+*				Window resizes are also queued, but the latest sizes are kept in dedicated fields
+*				so a full queue cannot lose them, and the size is known without querying GLFW.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <atomic>
+#include <bitset>
+
+struct GLFWwindow;
+class Input {
+public:
+	enum EventType {
+		KEY_EVENT,
+		MOUSE_BUTTON_EVENT,
+		MOUSE_MOVE_EVENT,
+		SCROLL_EVENT,
+		CHAR_EVENT,
+		// new size in x, y, in pixels for the framebuffer and in screen units for the window
+		FRAMEBUFFER_SIZE_EVENT,
+		WINDOW_SIZE_EVENT
+	};
+
+	struct Event {
+		EventType type;
+		// seconds since GLFW was initialized
+		double time;
+		// key, mouse button or unicode codepoint
+		int code;
+		// GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+		int action;
+		int mods;
+		// cursor position, scroll offset or size
+		float x, y;
+	};
+
+	Input();
+
+	// registers the key, mouse, scroll, char and resize callbacks of the window
+	void attach(GLFWwindow* window);
+
+	// drains the queued events and snapshots the key and button state,
+	// call once per frame after glfwPollEvents
+	void update();
+
+	// true while the key is held down
+	bool isKeyDown(int key) const;
+
+	// true if the key went down during the last frame
+	bool wasKeyPressed(int key) const;
+
+	// true if the key went up during the last frame
+	bool wasKeyReleased(int key) const;
+
+	bool isMouseButtonDown(int button) const;
+	bool wasMouseButtonPressed(int button) const;
+	bool wasMouseButtonReleased(int button) const;
+
+	float getMouseX() const { return m_mouseX; }
+	float getMouseY() const { return m_mouseY; }
+
+	// scroll offset accumulated during the last frame
+	float getScrollX() const { return m_scrollX; }
+	float getScrollY() const { return m_scrollY; }
+
+	// size of the framebuffer in pixels
+	int getFramebufferWidth() const { return m_framebufferWidth; }
+	int getFramebufferHeight() const { return m_framebufferHeight; }
+
+	// pixels per screen unit, above 1 on high DPI displays
+	float getContentScaleX() const { return m_contentScaleX; }
+	float getContentScaleY() const { return m_contentScaleY; }
+
+	// true if the framebuffer or the window changed size during the last frame
+	bool wasResized() const { return m_resized; }
+
+	// events received during the last frame, in arrival order
+	int getEventCount() const { return m_frameEventCount; }
+	const Event& getEvent(int index) const { return m_frameEvents[index]; }
+
+	// events lost because the queue was full
+	unsigned int getDroppedEventCount() const { return m_droppedEvents.load(std::memory_order_relaxed); }
+
+protected:
+	// QUEUE_SIZE must be a power of two
+	enum { QUEUE_SIZE = 4096, MAX_KEYS = 512, MAX_BUTTONS = 8 };
+
+	// producer side, called from the GLFW callbacks
+	void push(EventType type, int code, int action, int mods, float x, float y);
+
+	static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+	static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+	static void cursorPosCallback(GLFWwindow* window, double x, double y);
+	static void scrollCallback(GLFWwindow* window, double x, double y);
+	static void charCallback(GLFWwindow* window, unsigned int codepoint);
+	static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+	static void windowSizeCallback(GLFWwindow* window, int width, int height);
+
+	// derives the content scale from the framebuffer and window sizes
+	void updateContentScale();
+
+	GLFWwindow* m_window;
+
+	// single producer / single consumer ring buffer
+	Event m_queue[QUEUE_SIZE];
+	std::atomic<unsigned int> m_head;
+	std::atomic<unsigned int> m_tail;
+	std::atomic<unsigned int> m_droppedEvents;
+
+	Event m_frameEvents[QUEUE_SIZE];
+	int m_frameEventCount;
+
+	std::bitset<MAX_KEYS> m_keys;
+	std::bitset<MAX_KEYS> m_keysPressed;
+	std::bitset<MAX_KEYS> m_keysReleased;
+
+	std::bitset<MAX_BUTTONS> m_buttons;
+	std::bitset<MAX_BUTTONS> m_buttonsPressed;
+	std::bitset<MAX_BUTTONS> m_buttonsReleased;
+
+	float m_mouseX, m_mouseY;
+	float m_scrollX, m_scrollY;
+
+	int m_framebufferWidth, m_framebufferHeight;
+	int m_windowWidth, m_windowHeight;
+	float m_contentScaleX, m_contentScaleY;
+	bool m_resized;
+
+	// latest sizes written by the size callbacks, applied by update
+	std::atomic<int> m_pendingFramebufferWidth, m_pendingFramebufferHeight;
+	std::atomic<int> m_pendingWindowWidth, m_pendingWindowHeight;
+	std::atomic<bool> m_resizePending;
+};
+
+#endif // !INPUT_H_
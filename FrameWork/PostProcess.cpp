@@ -0,0 +1,321 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: PostProcess.cpp
+*
+* Description:	Effects run on the finished frame, bloom, blur and color grading.
+*				They work on a pyramid of downsampled targets from the pool, blur with
+*				separable gaussians that read two texels per linearly filtered tap,
+*				and end in one pass that writes the screen.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "PostProcess.h"
+#include "GLDebug.h"
+#include "RenderTarget.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+// sigma a blur pass does at most, wider blurs are done on a smaller level of the pyramid
+static const float MAX_SIGMA = 4.0f;
+// sigma of the blur of each bloom level, in texels of that level
+static const float BLOOM_SIGMA = 2.0f;
+
+PostProcess::PostProcess(const char* glslVersion, RenderTargetPool* pool) : m_pool(pool) {
+	m_settings.bloomIntensity = 0.0f;
+	m_settings.bloomThreshold = 0.8f;
+	m_settings.bloomLevels = 5;
+	m_settings.blur = 0.0f;
+	m_settings.exposure = 1.0f;
+	m_settings.contrast = 1.0f;
+	m_settings.saturation = 1.0f;
+	std::fill(m_settings.tint, m_settings.tint + 3, 1.0f);
+
+	// one triangle covering the screen, uv runs 0 to 1 over the visible part
+	const char* vertexShaderSource =
+		"out vec2 uv;\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+		"	uv = corner;\n"
+		"	gl_Position = vec4(corner * 2.0f - 1.0f, 0.0f, 1.0f);\n"
+		"}\0";
+	// each linear tap lands on the corner of 2x2 texels, so 4 taps average 4x4
+	const char* downsampleShaderSource =
+		"out vec4 FragColor;\n"
+		"in vec2 uv;\n"
+		"uniform sampler2D source;\n"
+		"uniform vec2 texel;\n"
+		"uniform float threshold;\n"
+		"void main()\n"
+		"{\n"
+		"	vec3 color = 0.25f * (texture(source, uv + vec2(-texel.x, -texel.y)).rgb\n"
+		"		+ texture(source, uv + vec2(texel.x, -texel.y)).rgb\n"
+		"		+ texture(source, uv + vec2(-texel.x, texel.y)).rgb\n"
+		"		+ texture(source, uv + vec2(texel.x, texel.y)).rgb);\n"
+		"	if (threshold >= 0.0f) {\n"
+		"		float brightness = max(color.r, max(color.g, color.b));\n"
+		"		color *= max(brightness - threshold, 0.0f) / max(brightness, 1e-4f);\n"
+		"	}\n"
+		"	FragColor = vec4(color, 1.0f);\n"
+		"}\0";
+	const char* blurShaderSource =
+		"out vec4 FragColor;\n"
+		"in vec2 uv;\n"
+		"uniform sampler2D source;\n"
+		"uniform vec2 direction;\n"
+		"uniform int taps;\n"
+		"uniform float offsets[8];\n"
+		"uniform float weights[8];\n"
+		"void main()\n"
+		"{\n"
+		"	vec3 color = texture(source, uv).rgb * weights[0];\n"
+		"	for (int i = 1; i < taps; ++i) {\n"
+		"		vec2 offset = direction * offsets[i];\n"
+		"		color += (texture(source, uv + offset).rgb + texture(source, uv - offset).rgb) * weights[i];\n"
+		"	}\n"
+		"	FragColor = vec4(color, 1.0f);\n"
+		"}\0";
+	const char* copyShaderSource =
+		"out vec4 FragColor;\n"
+		"in vec2 uv;\n"
+		"uniform sampler2D source;\n"
+		"void main()\n"
+		"{\n"
+		"	FragColor = vec4(texture(source, uv).rgb, 1.0f);\n"
+		"}\0";
+	const char* compositeShaderSource =
+		"out vec4 FragColor;\n"
+		"in vec2 uv;\n"
+		"uniform sampler2D scene;\n"
+		"uniform sampler2D bloom;\n"
+		"uniform sampler2D blurred;\n"
+		"uniform bool useBloom;\n"
+		"uniform bool useBlur;\n"
+		"uniform float bloomIntensity;\n"
+		"uniform float exposure;\n"
+		"uniform float contrast;\n"
+		"uniform float saturation;\n"
+		"uniform vec3 tint;\n"
+		"void main()\n"
+		"{\n"
+		"	vec3 color = (useBlur ? texture(blurred, uv).rgb : texture(scene, uv).rgb);\n"
+		"	if (useBloom) {\n"
+		"		color += texture(bloom, uv).rgb * bloomIntensity;\n"
+		"	}\n"
+		"	color *= exposure * tint;\n"
+		"	color = (color - 0.5f) * contrast + 0.5f;\n"
+		"	float luma = dot(color, vec3(0.2126f, 0.7152f, 0.0722f));\n"
+		"	color = mix(vec3(luma), color, saturation);\n"
+		"	FragColor = vec4(clamp(color, 0.0f, 1.0f), 1.0f);\n"
+		"}\0";
+
+	m_downsampleShader = Renderer2D::createProgram(glslVersion, vertexShaderSource, downsampleShaderSource);
+	m_downsampleTexel = glGetUniformLocation(m_downsampleShader, "texel");
+	m_downsampleThreshold = glGetUniformLocation(m_downsampleShader, "threshold");
+
+	m_blurShader = Renderer2D::createProgram(glslVersion, vertexShaderSource, blurShaderSource);
+	m_blurDirection = glGetUniformLocation(m_blurShader, "direction");
+	m_blurTaps = glGetUniformLocation(m_blurShader, "taps");
+	m_blurOffsets = glGetUniformLocation(m_blurShader, "offsets");
+	m_blurWeights = glGetUniformLocation(m_blurShader, "weights");
+
+	m_copyShader = Renderer2D::createProgram(glslVersion, vertexShaderSource, copyShaderSource);
+
+	m_compositeShader = Renderer2D::createProgram(glslVersion, vertexShaderSource, compositeShaderSource);
+	m_compositeBloom = glGetUniformLocation(m_compositeShader, "useBloom");
+	m_compositeBlur = glGetUniformLocation(m_compositeShader, "useBlur");
+	m_compositeBloomIntensity = glGetUniformLocation(m_compositeShader, "bloomIntensity");
+	m_compositeExposure = glGetUniformLocation(m_compositeShader, "exposure");
+	m_compositeContrast = glGetUniformLocation(m_compositeShader, "contrast");
+	m_compositeSaturation = glGetUniformLocation(m_compositeShader, "saturation");
+	m_compositeTint = glGetUniformLocation(m_compositeShader, "tint");
+	// the composite reads the scene, the bloom and the blurred scene from units 0 to 2
+	glUseProgram(m_compositeShader);
+	glUniform1i(glGetUniformLocation(m_compositeShader, "scene"), 0);
+	glUniform1i(glGetUniformLocation(m_compositeShader, "bloom"), 1);
+	glUniform1i(glGetUniformLocation(m_compositeShader, "blurred"), 2);
+	glUseProgram(0);
+
+	glGenVertexArrays(1, &m_VAO);
+	GLDebug::label(GL_VERTEX_ARRAY, m_VAO, "PostProcess fullscreen VAO");
+	GLDebug::label(GL_PROGRAM, m_downsampleShader, "PostProcess downsample program");
+	GLDebug::label(GL_PROGRAM, m_blurShader, "PostProcess blur program");
+	GLDebug::label(GL_PROGRAM, m_copyShader, "PostProcess copy program");
+	GLDebug::label(GL_PROGRAM, m_compositeShader, "PostProcess composite program");
+}
+
+void PostProcess::setSettings(const Renderer2D::PostProcessSettings& settings) {
+	m_settings = settings;
+	m_settings.bloomLevels = std::min(std::max(settings.bloomLevels, 1), (int)MAX_BLOOM_LEVELS);
+	m_settings.blur = std::max(settings.blur, 0.0f);
+}
+
+bool PostProcess::isEnabled() const {
+	const Renderer2D::PostProcessSettings& s = m_settings;
+	bool grading = (s.exposure != 1.0f || s.contrast != 1.0f || s.saturation != 1.0f
+		|| s.tint[0] != 1.0f || s.tint[1] != 1.0f || s.tint[2] != 1.0f);
+	return s.bloomIntensity > 0.0f || s.blur > 0.0f || grading;
+}
+
+int PostProcess::gaussianTaps(float sigma, float* offsets, float* weights) {
+	// texels out to 3 sigma, as many as MAX_TAPS paired taps reach
+	int radius = std::max(std::min((int)std::ceil(3.0f * sigma), 2 * (MAX_TAPS - 1)), 1);
+	float texels[2 * MAX_TAPS];
+	float sum = 0.0f;
+	for (int i = 0; i <= radius; ++i) {
+		texels[i] = std::exp(-(float)(i * i) / (2.0f * sigma * sigma));
+		sum += (i == 0 ? texels[i] : 2.0f * texels[i]);
+	}
+
+	offsets[0] = 0.0f;
+	weights[0] = texels[0] / sum;
+	int count = 1;
+	for (int i = 1; i <= radius; i += 2) {
+		float a = texels[i] / sum;
+		float b = (i + 1 <= radius ? texels[i + 1] / sum : 0.0f);
+		weights[count] = a + b;
+		offsets[count] = ((float)i * a + (float)(i + 1) * b) / (a + b);
+		++count;
+	}
+	return count;
+}
+
+void PostProcess::drawTo(unsigned int framebuffer, int width, int height) {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, width, height);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+}
+
+void PostProcess::downsample(const RenderTarget* source, RenderTarget* destination, float threshold) {
+	glUseProgram(m_downsampleShader);
+	glUniform2f(m_downsampleTexel, 1.0f / (float)source->width, 1.0f / (float)source->height);
+	glUniform1f(m_downsampleThreshold, threshold);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, source->texture);
+	drawTo(destination->framebuffer, destination->width, destination->height);
+}
+
+void PostProcess::blur(RenderTarget* target, float sigma) {
+	float offsets[MAX_TAPS];
+	float weights[MAX_TAPS];
+	int taps = gaussianTaps(sigma, offsets, weights);
+	RenderTarget* temporary = m_pool->acquire(target->width, target->height, target->format);
+
+	glUseProgram(m_blurShader);
+	glUniform1i(m_blurTaps, taps);
+	glUniform1fv(m_blurOffsets, taps, offsets);
+	glUniform1fv(m_blurWeights, taps, weights);
+	glActiveTexture(GL_TEXTURE0);
+
+	glUniform2f(m_blurDirection, 1.0f / (float)target->width, 0.0f);
+	glBindTexture(GL_TEXTURE_2D, target->texture);
+	drawTo(temporary->framebuffer, temporary->width, temporary->height);
+
+	glUniform2f(m_blurDirection, 0.0f, 1.0f / (float)target->height);
+	glBindTexture(GL_TEXTURE_2D, temporary->texture);
+	drawTo(target->framebuffer, target->width, target->height);
+
+	m_pool->release(temporary);
+}
+
+void PostProcess::apply(const RenderTarget* scene, unsigned int framebuffer, bool invalidate) {
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glBindVertexArray(m_VAO);
+
+	// bloom, the bright parts go down a pyramid of half sized levels, each level is
+	// blurred and the levels are added back up, so the glow reaches far at little cost
+	RenderTarget* bloom = nullptr;
+	if (m_settings.bloomIntensity > 0.0f) {
+		// 11-11-10 float keeps the sum of the levels above 1 at the size of RGBA8
+		RenderTarget* levels[MAX_BLOOM_LEVELS];
+		int levelCount = 0;
+		const RenderTarget* source = scene;
+		while (levelCount < m_settings.bloomLevels && (levelCount == 0 || (source->width > 1 && source->height > 1))) {
+			RenderTarget* level = m_pool->acquire(source->width / 2, source->height / 2, GL_R11F_G11F_B10F);
+			downsample(source, level, levelCount == 0 ? m_settings.bloomThreshold : -1.0f);
+			levels[levelCount++] = level;
+			source = level;
+		}
+		for (int i = 0; i < levelCount; ++i) {
+			blur(levels[i], BLOOM_SIGMA);
+		}
+
+		glUseProgram(m_copyShader);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE);
+		glActiveTexture(GL_TEXTURE0);
+		for (int i = levelCount - 1; i > 0; --i) {
+			glBindTexture(GL_TEXTURE_2D, levels[i]->texture);
+			drawTo(levels[i - 1]->framebuffer, levels[i - 1]->width, levels[i - 1]->height);
+			m_pool->release(levels[i]);
+		}
+		glDisable(GL_BLEND);
+		bloom = levels[0];
+	}
+
+	// blur, done on the level of the pyramid where the gaussian fits into one pass,
+	// at least half size, the composite scales it back up with the linear filter
+	RenderTarget* blurred = nullptr;
+	if (m_settings.blur > 0.0f) {
+		const RenderTarget* source = scene;
+		float sigma = m_settings.blur;
+		do {
+			RenderTarget* level = m_pool->acquire(source->width / 2, source->height / 2, scene->format);
+			downsample(source, level, -1.0f);
+			if (blurred != nullptr) {
+				m_pool->release(blurred);
+			}
+			blurred = level;
+			source = level;
+			sigma *= 0.5f;
+		} while (sigma > MAX_SIGMA && source->width > 1 && source->height > 1);
+		blur(blurred, sigma);
+	}
+
+	// grading and the composite in a single pass over the screen, which is not read back first
+	if (invalidate) {
+		GLenum attachment = (framebuffer == 0 ? GL_COLOR : GL_COLOR_ATTACHMENT0);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &attachment);
+	}
+	glUseProgram(m_compositeShader);
+	glUniform1i(m_compositeBloom, bloom != nullptr);
+	glUniform1i(m_compositeBlur, blurred != nullptr);
+	glUniform1f(m_compositeBloomIntensity, m_settings.bloomIntensity);
+	glUniform1f(m_compositeExposure, m_settings.exposure);
+	glUniform1f(m_compositeContrast, m_settings.contrast);
+	glUniform1f(m_compositeSaturation, m_settings.saturation);
+	glUniform3f(m_compositeTint, m_settings.tint[0], m_settings.tint[1], m_settings.tint[2]);
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, blurred != nullptr ? blurred->texture : scene->texture);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, bloom != nullptr ? bloom->texture : scene->texture);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, scene->texture);
+	drawTo(framebuffer, scene->width, scene->height);
+
+	if (bloom != nullptr) {
+		m_pool->release(bloom);
+	}
+	if (blurred != nullptr) {
+		m_pool->release(blurred);
+	}
+	glBindVertexArray(0);
+}
+
+PostProcess::~PostProcess() {
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteProgram(m_downsampleShader);
+	glDeleteProgram(m_blurShader);
+	glDeleteProgram(m_copyShader);
+	glDeleteProgram(m_compositeShader);
+}
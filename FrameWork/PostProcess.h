@@ -0,0 +1,91 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: PostProcess.h
+*
+* Description:	Effects run on the finished frame, bloom, blur and color grading.
+*				They work on a pyramid of downsampled targets from the pool, blur with
+*				separable gaussians that read two texels per linearly filtered tap,
+*				and end in one pass that writes the screen.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef POSTPROCESS_H_
+#define POSTPROCESS_H_
+
+#include "Renderer2D.h"
+
+struct RenderTarget;
+class RenderTargetPool;
+class PostProcess {
+public:
+	enum {
+		// taps of a blur pass after pairing, 8 cover a gaussian of up to 14 texels per side
+		MAX_TAPS = 8,
+		MAX_BLOOM_LEVELS = 6
+	};
+
+	// @param glslVersion - #version line of the shaders
+	// @param pool - targets of the intermediate passes
+	PostProcess(const char* glslVersion, RenderTargetPool* pool);
+
+	void setSettings(const Renderer2D::PostProcessSettings& settings);
+	const Renderer2D::PostProcessSettings& getSettings() const { return m_settings; }
+
+	// true if any effect is on, otherwise the frame is drawn straight to the screen
+	bool isEnabled() const;
+
+	// runs the effects on scene and writes the result over all of framebuffer,
+	// leaves blending and depth testing off
+	// @param invalidate - drop the color of framebuffer first, it is overwritten anyway,
+	//        needs glInvalidateFramebuffer
+	void apply(const RenderTarget* scene, unsigned int framebuffer, bool invalidate);
+
+	~PostProcess();
+
+protected:
+	// fills the taps of a normalized gaussian, each pair of neighbouring texels becomes one tap
+	// between them, weighted so the linear filter returns their weighted sum
+	// @param sigma - standard deviation in texels
+	// @param offsets, weights - MAX_TAPS entries, the first tap is the center texel
+	// @return number of taps
+	static int gaussianTaps(float sigma, float* offsets, float* weights);
+
+	// averages 4x4 texels of source into each texel of destination with 4 linear taps
+	// @param threshold - only brightness above it is kept, negative keeps everything
+	void downsample(const RenderTarget* source, RenderTarget* destination, float threshold);
+
+	// blurs target in place, horizontally into a pooled target and vertically back
+	// @param sigma - standard deviation in texels of target
+	void blur(RenderTarget* target, float sigma);
+
+	// binds destination, sets the viewport to it and draws the fullscreen triangle
+	void drawTo(unsigned int framebuffer, int width, int height);
+
+	Renderer2D::PostProcessSettings m_settings;
+
+	RenderTargetPool* m_pool;
+
+	// the fullscreen triangle comes from gl_VertexID, the VAO has no attributes
+	unsigned int m_VAO;
+
+	unsigned int m_downsampleShader;
+	int m_downsampleTexel, m_downsampleThreshold;
+
+	unsigned int m_blurShader;
+	int m_blurDirection, m_blurTaps, m_blurOffsets, m_blurWeights;
+
+	unsigned int m_copyShader;
+
+	unsigned int m_compositeShader;
+	int m_compositeBloom, m_compositeBlur, m_compositeBloomIntensity;
+	int m_compositeExposure, m_compositeContrast, m_compositeSaturation, m_compositeTint;
+};
+
+#endif // !POSTPROCESS_H_
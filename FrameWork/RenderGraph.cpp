@@ -0,0 +1,392 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: RenderGraph.cpp
+*
+* Description:	Frame graph of off-screen passes drawn with the renderer. Passes declare
+*				the targets they read and write, passes whose results nobody reads are
+*				culled, the rest are ordered by their dependencies, and targets that only
+*				live for the frame share memory when their lifetimes do not overlap.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "RenderGraph.h"
+#include "GLCaps.h"
+#include "Renderer2D.h"
+#include "RenderTarget.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+
+RenderGraph::RenderGraph(Renderer2D* renderer) : m_renderer(renderer), m_compiled(false), m_sharedTargets(0) {
+}
+
+int RenderGraph::createTarget(const char* name, int width, int height, unsigned int format, bool depth) {
+	Resource resource;
+	resource.name = name;
+	resource.width = width;
+	resource.height = height;
+	resource.format = format;
+	resource.depth = depth;
+	resource.imported = false;
+	resource.screen = false;
+	resource.target = nullptr;
+	m_resources.push_back(resource);
+	m_compiled = false;
+	return (int)m_resources.size() - 1;
+}
+
+int RenderGraph::importTarget(const char* name, RenderTarget* target) {
+	int handle = createTarget(name, target->width, target->height, target->format, target->depth != 0);
+	m_resources[handle].imported = true;
+	m_resources[handle].target = target;
+	return handle;
+}
+
+int RenderGraph::importScreen() {
+	int handle = createTarget("screen", 0, 0, 0, true);
+	m_resources[handle].imported = true;
+	m_resources[handle].screen = true;
+	return handle;
+}
+
+int RenderGraph::addPass(const char* name, PassFunction execute, void* user) {
+	Pass pass;
+	pass.name = name;
+	pass.execute = execute;
+	pass.user = user;
+	pass.culled = false;
+	pass.writes = 0;
+	pass.sideEffect = false;
+	m_passes.push_back(pass);
+	m_compiled = false;
+	return (int)m_passes.size() - 1;
+}
+
+void RenderGraph::read(int pass, int resource) {
+	Access access = { resource, false, false, { 0.0f, 0.0f, 0.0f, 0.0f } };
+	m_passes[pass].accesses.push_back(access);
+	m_compiled = false;
+}
+
+void RenderGraph::write(int pass, int resource, const float* clearColor) {
+	Access access = { resource, true, clearColor != nullptr, { 0.0f, 0.0f, 0.0f, 0.0f } };
+	if (clearColor != nullptr) {
+		std::copy(clearColor, clearColor + 4, access.clearColor);
+	}
+	m_passes[pass].accesses.push_back(access);
+	m_compiled = false;
+}
+
+bool RenderGraph::writes(const Pass& pass, int resource) const {
+	for (size_t i = 0; i < pass.accesses.size(); ++i) {
+		if (pass.accesses[i].write && pass.accesses[i].resource == resource) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool RenderGraph::reads(const Pass& pass, int resource) const {
+	for (size_t i = 0; i < pass.accesses.size(); ++i) {
+		if (!pass.accesses[i].write && pass.accesses[i].resource == resource) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int RenderGraph::firstWrite(const Pass& pass) const {
+	for (size_t i = 0; i < pass.accesses.size(); ++i) {
+		if (pass.accesses[i].write) {
+			return pass.accesses[i].resource;
+		}
+	}
+	return -1;
+}
+
+bool RenderGraph::compile() {
+	int passCount = (int)m_passes.size();
+	int resourceCount = (int)m_resources.size();
+
+	// culling, a resource nobody reads makes its writers useless, unless it is imported,
+	// and a culled pass no longer needs what it reads, which may cull its producers in turn
+	for (int i = 0; i < resourceCount; ++i) {
+		m_resources[i].readers = 0;
+	}
+	for (int i = 0; i < passCount; ++i) {
+		Pass& pass = m_passes[i];
+		pass.culled = false;
+		pass.writes = 0;
+		pass.sideEffect = false;
+		for (size_t j = 0; j < pass.accesses.size(); ++j) {
+			const Access& access = pass.accesses[j];
+			if (access.write) {
+				++pass.writes;
+				pass.sideEffect = pass.sideEffect || m_resources[access.resource].imported;
+			}
+			else if (!writes(pass, access.resource)) {
+				++m_resources[access.resource].readers;
+			}
+		}
+	}
+	std::vector<int> unused;
+	for (int i = 0; i < resourceCount; ++i) {
+		if (m_resources[i].readers == 0 && !m_resources[i].imported) {
+			unused.push_back(i);
+		}
+	}
+	while (!unused.empty()) {
+		int resource = unused.back();
+		unused.pop_back();
+		for (int i = 0; i < passCount; ++i) {
+			Pass& pass = m_passes[i];
+			if (pass.culled || pass.sideEffect || !writes(pass, resource) || --pass.writes > 0) {
+				continue;
+			}
+			pass.culled = true;
+			for (size_t j = 0; j < pass.accesses.size(); ++j) {
+				const Access& access = pass.accesses[j];
+				if (!access.write && !writes(pass, access.resource) && --m_resources[access.resource].readers == 0
+					&& !m_resources[access.resource].imported) {
+					unused.push_back(access.resource);
+				}
+			}
+		}
+	}
+
+	// ordering, every write makes a new version of the resource, a reader runs after the
+	// write added last before it and before the next write, which would replace the version
+	// it reads, writers of the same resource keep the order they were added in, ties go to
+	// the earlier added pass, so ping-ponging between two targets is no cycle
+	std::vector<std::vector<int> > successors(passCount);
+	std::vector<int> predecessors(passCount, 0);
+	std::vector<int> versionReaders;
+	std::vector<int> earlyReaders;
+	for (int resource = 0; resource < resourceCount; ++resource) {
+		int previousWriter = -1;
+		versionReaders.clear();
+		earlyReaders.clear();
+		for (int i = 0; i < passCount; ++i) {
+			const Pass& pass = m_passes[i];
+			if (pass.culled) {
+				continue;
+			}
+			if (writes(pass, resource)) {
+				if (previousWriter >= 0) {
+					successors[previousWriter].push_back(i);
+					++predecessors[i];
+				}
+				if (previousWriter < 0 && !m_resources[resource].imported) {
+					// a transient target has nothing to read before its first write
+					earlyReaders.swap(versionReaders);
+				}
+				for (size_t j = 0; j < versionReaders.size(); ++j) {
+					successors[versionReaders[j]].push_back(i);
+					++predecessors[i];
+				}
+				versionReaders.clear();
+				previousWriter = i;
+			}
+			else if (reads(pass, resource)) {
+				if (previousWriter >= 0) {
+					successors[previousWriter].push_back(i);
+					++predecessors[i];
+				}
+				versionReaders.push_back(i);
+			}
+		}
+		// passes added before the first writer of a transient target read its last version
+		for (size_t j = 0; previousWriter >= 0 && j < earlyReaders.size(); ++j) {
+			successors[previousWriter].push_back(earlyReaders[j]);
+			++predecessors[earlyReaders[j]];
+		}
+	}
+	m_order.clear();
+	std::vector<bool> scheduled(passCount, false);
+	bool progress = true;
+	while (progress) {
+		progress = false;
+		for (int i = 0; i < passCount; ++i) {
+			if (scheduled[i] || m_passes[i].culled || predecessors[i] > 0) {
+				continue;
+			}
+			scheduled[i] = true;
+			m_order.push_back(i);
+			for (size_t j = 0; j < successors[i].size(); ++j) {
+				--predecessors[successors[i][j]];
+			}
+			progress = true;
+			break;
+		}
+	}
+	bool acyclic = true;
+	for (int i = 0; i < passCount; ++i) {
+		if (!m_passes[i].culled && !scheduled[i]) {
+			acyclic = false;
+		}
+	}
+	if (!acyclic) {
+		std::cout << "ERROR::RENDERGRAPH::CYCLE passes run in the order they were added" << std::endl;
+		m_order.clear();
+		for (int i = 0; i < passCount; ++i) {
+			if (!m_passes[i].culled) {
+				m_order.push_back(i);
+			}
+		}
+	}
+
+	// lifetimes, transient targets are allocated at their first use and handed back after the last
+	for (int i = 0; i < resourceCount; ++i) {
+		m_resources[i].firstUse = -1;
+		m_resources[i].lastUse = -1;
+		m_resources[i].lastWrite = -1;
+	}
+	for (int position = 0; position < (int)m_order.size(); ++position) {
+		const Pass& pass = m_passes[m_order[position]];
+		for (size_t j = 0; j < pass.accesses.size(); ++j) {
+			Resource& resource = m_resources[pass.accesses[j].resource];
+			if (resource.firstUse < 0) {
+				resource.firstUse = position;
+			}
+			resource.lastUse = position;
+			if (pass.accesses[j].write) {
+				resource.lastWrite = position;
+			}
+		}
+	}
+	m_compiled = true;
+	return acyclic;
+}
+
+void RenderGraph::invalidate(const Resource& resource, bool color, bool depth) {
+	if (!m_renderer->getCaps()->invalidateFramebuffer || resource.imported || resource.target == nullptr) {
+		return;
+	}
+	GLenum attachments[2];
+	int count = 0;
+	if (color) {
+		attachments[count++] = GL_COLOR_ATTACHMENT0;
+	}
+	if (depth && resource.depth) {
+		attachments[count++] = GL_DEPTH_STENCIL_ATTACHMENT;
+	}
+	if (count > 0) {
+		glBindFramebuffer(GL_FRAMEBUFFER, resource.target->framebuffer);
+		glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments);
+	}
+}
+
+void RenderGraph::execute() {
+	if (!m_compiled) {
+		compile();
+	}
+	RenderTargetPool* pool = m_renderer->getTargetPool();
+	RenderTarget* previousTarget = m_renderer->getRenderTarget();
+	// the graph clears and invalidates the targets itself, begin() inside a pass keeps them
+	Renderer2D::RenderPass previousPass = m_renderer->getDefaultPass();
+	Renderer2D::RenderPass keep = previousPass;
+	keep.colorLoad = Renderer2D::LOAD_KEEP;
+	keep.depthLoad = Renderer2D::LOAD_KEEP;
+	keep.colorStore = Renderer2D::STORE_KEEP;
+	keep.depthStore = Renderer2D::STORE_KEEP;
+	m_renderer->setDefaultPass(keep);
+	std::vector<RenderTarget*> used;
+
+	for (int position = 0; position < (int)m_order.size(); ++position) {
+		Pass& pass = m_passes[m_order[position]];
+
+		// transient targets come from the pool as late as possible, so a target handed
+		// back by an earlier pass is taken again, and start undefined
+		for (size_t j = 0; j < pass.accesses.size(); ++j) {
+			Resource& resource = m_resources[pass.accesses[j].resource];
+			if (!resource.imported && resource.firstUse == position && resource.target == nullptr) {
+				resource.target = pool->acquire(resource.width, resource.height, resource.format, resource.depth);
+				if (std::find(used.begin(), used.end(), resource.target) == used.end()) {
+					used.push_back(resource.target);
+				}
+				if (!pass.accesses[j].clear) {
+					invalidate(resource, true, true);
+				}
+			}
+		}
+
+		// each target is cleared once, with one call for color, depth and stencil
+		for (size_t j = 0; j < pass.accesses.size(); ++j) {
+			const Access& access = pass.accesses[j];
+			if (!access.clear) {
+				continue;
+			}
+			const Resource& resource = m_resources[access.resource];
+			glBindFramebuffer(GL_FRAMEBUFFER, resource.screen ? 0 : resource.target->framebuffer);
+			glClearColor(access.clearColor[0], access.clearColor[1], access.clearColor[2], access.clearColor[3]);
+			glClear(GL_COLOR_BUFFER_BIT | (resource.depth ? GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT : 0));
+		}
+
+		// the renderer draws into the first target the pass writes, over the whole target
+		int output = firstWrite(pass);
+		RenderTarget* target = (output >= 0 ? m_resources[output].target : nullptr);
+		m_renderer->setRenderTarget(target);
+		glBindFramebuffer(GL_FRAMEBUFFER, target != nullptr ? target->framebuffer : 0);
+		if (target != nullptr) {
+			glViewport(0, 0, target->width, target->height);
+		}
+		pass.execute(*this, pass.user);
+
+		// depth is dead after the last write and color after the last read,
+		// so the driver neither stores nor reloads them, then the target goes back to the pool
+		for (size_t j = 0; j < pass.accesses.size(); ++j) {
+			Resource& resource = m_resources[pass.accesses[j].resource];
+			if (resource.imported || resource.target == nullptr) {
+				continue;
+			}
+			if (resource.lastUse == position) {
+				invalidate(resource, true, resource.lastWrite == position);
+				pool->release(resource.target);
+				resource.target = nullptr;
+			}
+			else if (resource.lastWrite == position && pass.accesses[j].write) {
+				invalidate(resource, false, true);
+			}
+		}
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	m_renderer->setRenderTarget(previousTarget);
+	m_renderer->setDefaultPass(previousPass);
+	m_sharedTargets = (int)used.size();
+}
+
+RenderTarget* RenderGraph::getTarget(int resource) const {
+	return m_resources[resource].target;
+}
+
+void RenderGraph::reset() {
+	m_resources.clear();
+	m_passes.clear();
+	m_order.clear();
+	m_compiled = false;
+}
+
+void RenderGraph::report() const {
+	std::cout << "RenderGraph: " << m_order.size() << " of " << m_passes.size() << " passes run:";
+	for (size_t i = 0; i < m_order.size(); ++i) {
+		std::cout << (i == 0 ? " " : ", ") << m_passes[m_order[i]].name;
+	}
+	std::cout << std::endl;
+	for (size_t i = 0; i < m_passes.size(); ++i) {
+		if (m_passes[i].culled) {
+			std::cout << "  culled " << m_passes[i].name << std::endl;
+		}
+	}
+	int transient = 0;
+	for (size_t i = 0; i < m_resources.size(); ++i) {
+		transient += (!m_resources[i].imported && m_resources[i].firstUse >= 0 ? 1 : 0);
+	}
+	std::cout << "  " << transient << " transient targets on " << m_sharedTargets << " allocations" << std::endl;
+}
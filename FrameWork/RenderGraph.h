@@ -0,0 +1,137 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: RenderGraph.h
+*
+* Description:	Frame graph of off-screen passes drawn with the renderer. Passes declare
+*				the targets they read and write, passes whose results nobody reads are
+*				culled, the rest are ordered by their dependencies, and targets that only
+*				live for the frame share memory when their lifetimes do not overlap.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef RENDERGRAPH_H_
+#define RENDERGRAPH_H_
+
+#include <string>
+#include <vector>
+
+class Renderer2D;
+struct RenderTarget;
+class RenderGraph {
+public:
+	// draws a pass, the renderer already draws into the first target the pass writes,
+	// and its begin() keeps what the graph cleared, begin() and end() only open and close the pass,
+	// the frame is finished once by Renderer2D::endFrame
+	typedef void (*PassFunction)(RenderGraph& graph, void* user);
+
+	explicit RenderGraph(Renderer2D* renderer);
+
+	// target that only lives for the frame, taken from the pool of the renderer when the
+	// first pass using it runs and handed back after the last one, its contents start undefined
+	// @param depth - with a depth stencil buffer, for passes drawing opaque primitives
+	// @return handle of the resource
+	int createTarget(const char* name, int width, int height, unsigned int format, bool depth = false);
+
+	// target that outlives the frame, passes writing it are never culled
+	int importTarget(const char* name, RenderTarget* target);
+
+	// the default framebuffer, passes writing it are never culled
+	int importScreen();
+
+	// @return handle of the pass
+	int addPass(const char* name, PassFunction execute, void* user = nullptr);
+
+	// the pass samples resource as the writer added last before it left it, it runs after
+	// that pass and before the next pass writing resource, a pass added before every writer
+	// sees what an imported resource held, or the last version of a transient target
+	void read(int pass, int resource);
+
+	// the pass draws into resource, passes writing the same resource run in the order they were added
+	// @param clearColor - rgba the target, and its depth and stencil, are cleared to before the pass,
+	//        nullptr keeps what earlier passes drew, or leaves a new target undefined
+	void write(int pass, int resource, const float* clearColor = nullptr);
+
+	// culls the passes that do not lead to an imported resource, orders the others
+	// and finds the first and last pass using each target
+	// @return false if the passes depend on each other in a cycle, they then run in the order they were added
+	bool compile();
+
+	// runs the compiled passes
+	void execute();
+
+	// target of a resource while the passes run, nullptr for the screen
+	// and for transient targets outside the passes using them
+	RenderTarget* getTarget(int resource) const;
+
+	// removes the passes and resources, graphs are built again every frame
+	void reset();
+
+	// prints the order of the passes, the culled ones and which targets were shared
+	void report() const;
+
+protected:
+	struct Resource {
+		std::string name;
+		int width, height;
+		unsigned int format;
+		bool depth;
+		// imported targets and the screen are kept as they are
+		bool imported;
+		bool screen;
+		RenderTarget* target;
+		// passes reading it, without the ones that also write it
+		int readers;
+		// positions in m_order of the first and last pass using it and the last pass writing it
+		int firstUse, lastUse, lastWrite;
+	};
+
+	struct Access {
+		int resource;
+		bool write;
+		bool clear;
+		float clearColor[4];
+	};
+
+	struct Pass {
+		std::string name;
+		PassFunction execute;
+		void* user;
+		std::vector<Access> accesses;
+		bool culled;
+		// resources written that are still needed, the pass is culled at 0
+		int writes;
+		// writes an imported resource
+		bool sideEffect;
+	};
+
+	// true if pass writes resource
+	bool writes(const Pass& pass, int resource) const;
+
+	// true if pass samples resource
+	bool reads(const Pass& pass, int resource) const;
+
+	// the first resource the pass writes, -1 if it writes none
+	int firstWrite(const Pass& pass) const;
+
+	// drops the attachments of a transient target whose contents are not needed anymore
+	void invalidate(const Resource& resource, bool color, bool depth);
+
+	Renderer2D* m_renderer;
+
+	std::vector<Resource> m_resources;
+	std::vector<Pass> m_passes;
+	// passes that run, in the order they run
+	std::vector<int> m_order;
+	bool m_compiled;
+	// distinct targets the transient resources ran on at the last execute
+	int m_sharedTargets;
+};
+
+#endif // !RENDERGRAPH_H_
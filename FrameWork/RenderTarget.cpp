@@ -0,0 +1,156 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: RenderTarget.cpp
+*
+* Description:	Off-screen framebuffers and the pool they are borrowed from.
+*				Passes acquire a target for as long as they need it and release it,
+*				so targets of the same size and format are reused instead of created.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "RenderTarget.h"
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <iostream>
+
+/**
+	Pixel transfer format and size of a sized color format.
+	@param format - sized internal format
+	@param transfer, type - format and type glTexImage2D is called with
+	@return bytes per pixel
+*/
+static int describeFormat(unsigned int format, GLenum& transfer, GLenum& type) {
+	switch (format) {
+	case GL_R8:
+		transfer = GL_RED;
+		type = GL_UNSIGNED_BYTE;
+		return 1;
+	case GL_R11F_G11F_B10F:
+		transfer = GL_RGB;
+		type = GL_FLOAT;
+		return 4;
+	case GL_RGBA16F:
+		transfer = GL_RGBA;
+		type = GL_FLOAT;
+		return 8;
+	default:
+		transfer = GL_RGBA;
+		type = GL_UNSIGNED_BYTE;
+		return 4;
+	}
+}
+
+RenderTargetPool::RenderTargetPool() : m_frame(0) {
+}
+
+RenderTarget* RenderTargetPool::acquire(int width, int height, unsigned int format, bool depth) {
+	width = (width > 1 ? width : 1);
+	height = (height > 1 ? height : 1);
+	for (size_t i = 0; i < m_slots.size(); ++i) {
+		Slot& slot = m_slots[i];
+		const RenderTarget* target = slot.target;
+		if (!slot.used && target->width == width && target->height == height && target->format == format && (target->depth != 0) == depth) {
+			slot.used = true;
+			slot.lastFrame = m_frame;
+			return slot.target;
+		}
+	}
+	Slot slot = { create(width, height, format, depth), true, m_frame };
+	m_slots.push_back(slot);
+	return slot.target;
+}
+
+void RenderTargetPool::release(RenderTarget* target) {
+	for (size_t i = 0; i < m_slots.size(); ++i) {
+		if (m_slots[i].target == target) {
+			m_slots[i].used = false;
+			return;
+		}
+	}
+}
+
+void RenderTargetPool::trim(unsigned int frame) {
+	m_frame = frame;
+	size_t kept = 0;
+	for (size_t i = 0; i < m_slots.size(); ++i) {
+		Slot& slot = m_slots[i];
+		if (!slot.used && frame - slot.lastFrame > UNUSED_FRAMES) {
+			destroy(slot.target);
+			continue;
+		}
+		m_slots[kept++] = slot;
+	}
+	m_slots.resize(kept);
+}
+
+size_t RenderTargetPool::getMemory() const {
+	size_t bytes = 0;
+	for (size_t i = 0; i < m_slots.size(); ++i) {
+		const RenderTarget* target = m_slots[i].target;
+		GLenum transfer, type;
+		size_t pixel = (size_t)describeFormat(target->format, transfer, type) + (target->depth != 0 ? 4 : 0);
+		bytes += pixel * (size_t)target->width * (size_t)target->height;
+	}
+	return bytes;
+}
+
+RenderTarget* RenderTargetPool::create(int width, int height, unsigned int format, bool depth) {
+	RenderTarget* target = new RenderTarget();
+	target->width = width;
+	target->height = height;
+	target->format = format;
+	target->depth = 0;
+
+	// linear filtering lets the passes read between texels, which halves their taps
+	GLenum transfer, type;
+	describeFormat(format, transfer, type);
+	glGenTextures(1, &target->texture);
+	glBindTexture(GL_TEXTURE_2D, target->texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, transfer, type, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenFramebuffers(1, &target->framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target->texture, 0);
+	if (depth) {
+		glGenRenderbuffers(1, &target->depth);
+		glBindRenderbuffer(GL_RENDERBUFFER, target->depth);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target->depth);
+	}
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		std::cout << "ERROR::RENDERTARGET::FRAMEBUFFER_INCOMPLETE " << width << "x" << height << std::endl;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	GLDebug::label(GL_TEXTURE, target->texture, "RenderTarget color");
+	GLDebug::label(GL_FRAMEBUFFER, target->framebuffer, "RenderTarget framebuffer");
+	return target;
+}
+
+void RenderTargetPool::destroy(RenderTarget* target) {
+	glDeleteFramebuffers(1, &target->framebuffer);
+	glDeleteTextures(1, &target->texture);
+	if (target->depth != 0) {
+		glDeleteRenderbuffers(1, &target->depth);
+	}
+	delete target;
+}
+
+RenderTargetPool::~RenderTargetPool() {
+	for (size_t i = 0; i < m_slots.size(); ++i) {
+		destroy(m_slots[i].target);
+	}
+}
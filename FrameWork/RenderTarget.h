@@ -0,0 +1,77 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: RenderTarget.h
+*
+* Description:	Off-screen framebuffers and the pool they are borrowed from.
+*				Passes acquire a target for as long as they need it and release it,
+*				so targets of the same size and format are reused instead of created.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef RENDERTARGET_H_
+#define RENDERTARGET_H_
+
+#include <cstddef>
+#include <vector>
+
+// framebuffer with one color texture and an optional depth stencil buffer
+struct RenderTarget {
+	unsigned int framebuffer;
+	unsigned int texture;
+	// depth stencil renderbuffer, 0 without depth
+	unsigned int depth;
+	int width, height;
+	// sized internal format of the texture, GL_RGBA8, GL_R11F_G11F_B10F, ...
+	unsigned int format;
+};
+
+class RenderTargetPool {
+public:
+	enum {
+		// free targets not acquired for this many frames are deleted
+		UNUSED_FRAMES = 60
+	};
+
+	RenderTargetPool();
+
+	// a free target of this size and format, created when the pool has none,
+	// its contents are undefined
+	// @param depth - with a 24-bit depth and 8-bit stencil buffer
+	RenderTarget* acquire(int width, int height, unsigned int format, bool depth = false);
+
+	// hands a target back, the next acquire of the same size and format may return it
+	void release(RenderTarget* target);
+
+	// deletes the free targets not acquired since frame - UNUSED_FRAMES,
+	// such as the ones of a window size that is gone
+	void trim(unsigned int frame);
+
+	// targets created and GPU memory they hold in bytes
+	size_t getCount() const { return m_slots.size(); }
+	size_t getMemory() const;
+
+	~RenderTargetPool();
+
+protected:
+	struct Slot {
+		RenderTarget* target;
+		bool used;
+		unsigned int lastFrame;
+	};
+
+	// creates the texture, the depth buffer and the framebuffer of a target
+	static RenderTarget* create(int width, int height, unsigned int format, bool depth);
+	static void destroy(RenderTarget* target);
+
+	std::vector<Slot> m_slots;
+	unsigned int m_frame;
+};
+
+#endif // !RENDERTARGET_H_
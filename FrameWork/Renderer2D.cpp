@@ -15,44 +15,50 @@
 */
 
 #include "Renderer2D.h"
+#include "GLCaps.h"
+#include "GLDebug.h"
+#include "GLProfiler.h"
+#include "GlyphCache.h"
+#include "PostProcess.h"
+#include "RenderTarget.h"
+#include "ShapePool.h"
+#include "SortKey.h"
+#include "Stroke.h"
+#include "TextureLoader.h"
+#include "Triangulate.h"
+#include "VertexExpand.h"
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 #include <glm/ext.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 
-Renderer2D::Renderer2D() {
-	m_cameraScale = 1.0f;
-
-	SetColor(1.0f, 0.0f, 0.0f, 1.0f);
-	m_currentVertex = 0;
-	m_currentIndex = 0;
-	/* ------------------------------------------------------------------------- */
-	/* build and compile shader program */
-	const char * vertexShaderSource = "#version 460 core\n"
-		"layout (location = 0) in vec3 aPos;\n"
-		"layout (location = 1) in vec4 color;\n"
+// layers are spread over z 0 (front) to MAX_DEPTH (back), inside the near and far planes set in begin()
+static const float MAX_DEPTH = 100.0f;
 
-		"out vec4 vertexColor;\n"
-		
-		"uniform mat4 modelMatrix;\n"
-		"uniform mat4 viewMatrix;\n"
-		"uniform mat4 projectionMatrix;\n"
+/**
+* True if the ring sizes add up to the number of points, prints an error otherwise
+* @param count - number of points passed with the rings
+* @param ringSizes - points per ring
+*/
+static bool checkRings(int count, const int* ringSizes, int ringCount) {
+	int total = 0;
+	for (int i = 0; i < ringCount; ++i) {
+		total += ringSizes[i];
+	}
+	if (ringCount < 1 || total != count) {
+		std::cout << "ERROR::RENDERER2D::POLYGON::RING_SIZES_MISMATCH" << std::endl;
+		return false;
+	}
+	return true;
+}
 
-		"void main()\n"
-		"{\n"
-		"	gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(aPos, 1.0f);\n"
-		"	vertexColor = color;\n"
-		"}\0";
-	const char * fragmentShaderSource = "#version 460 core\n"
-		"out vec4 FragColor;\n"
-		"in vec4 vertexColor;\n"
-		"void main()\n"
-		"{\n"
-		"	FragColor = vertexColor;\n"
-		"}\0";
+unsigned int Renderer2D::createProgram(const char* version, const char* vertexShaderSource, const char* fragmentShaderSource) {
 	/* VERTEX SHADER */
+	const char* vertexSources[] = { version, vertexShaderSource };
 	unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
+	glShaderSource(vertexShader, 2, vertexSources, NULL);
 	glCompileShader(vertexShader);
 
 	// check for vertex shader compile errors
@@ -64,8 +70,9 @@ Renderer2D::Renderer2D() {
 		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
 	}
 	/* FRAGMENT SHADER */
+	const char* fragmentSources[] = { version, fragmentShaderSource };
 	unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
+	glShaderSource(fragmentShader, 2, fragmentSources, NULL);
 	glCompileShader(fragmentShader);
 
 	// check for fragment shader compile errors
@@ -76,19 +83,154 @@ Renderer2D::Renderer2D() {
 	}
 
 	// link shaders 
-	m_shader = glCreateProgram();
-	glAttachShader(m_shader, vertexShader);
-	glAttachShader(m_shader, fragmentShader);
-	glLinkProgram(m_shader);
+	unsigned int program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
 
 	// check for shader linking errors 
-	glGetProgramiv(m_shader, GL_LINK_STATUS, &success);
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
 	if (!success) {
-		glGetProgramInfoLog(m_shader, 512, NULL, infoLog);
+		glGetProgramInfoLog(program, 512, NULL, infoLog);
 		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 	}
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
+
+	return program;
+}
+
+Renderer2D::Renderer2D() {
+	// pick the code paths the context supports
+	m_caps = new GLCaps();
+	m_caps->detect((GLCaps::LoadProc)glfwGetProcAddress);
+	m_caps->report();
+	// every pointer is loaded now, wrap them when the GL calls are profiled
+	GL_PROFILER_INSTALL();
+	m_debug = new GLDebug();
+#ifdef OPENGLFW_GL_DEBUG
+	enableDebugOutput();
+#endif
+
+	// start from the size of the current window, later sizes come through resize
+	m_framebufferWidth = 0;
+	m_framebufferHeight = 0;
+	int windowWidth = 0;
+	int windowHeight = 0;
+	GLFWwindow* window = glfwGetCurrentContext();
+	if (window != nullptr) {
+		glfwGetFramebufferSize(window, &m_framebufferWidth, &m_framebufferHeight);
+		glfwGetWindowSize(window, &windowWidth, &windowHeight);
+	}
+	m_contentScaleX = (windowWidth > 0 ? (float)m_framebufferWidth / (float)windowWidth : 1.0f);
+	m_contentScaleY = (windowHeight > 0 ? (float)m_framebufferHeight / (float)windowHeight : 1.0f);
+	m_viewDirty = true;
+	std::fill(m_viewport, m_viewport + 4, 0);
+
+	SetColor(1.0f, 0.0f, 0.0f, 1.0f);
+	m_currentVertex = 0;
+	m_currentIndex = 0;
+	m_recording = false;
+	m_layer = 0;
+	m_blendMode = BLEND_ALPHA;
+	m_lineJoin = JOIN_MITER;
+	m_lineCap = CAP_BUTT;
+	m_appliedBlendMode = -1;
+	m_depthKey = 0;
+	m_depth = 0.0f;
+	m_frame = 0;
+	m_sequence = 0;
+	std::fill(m_layerPrimitives, m_layerPrimitives + MAX_LAYERS, 0);
+	m_commands.reserve(MAX_INDICES / 3);
+	/* ------------------------------------------------------------------------- */
+	/* build and compile shader program, the #version line comes from the detected context */
+	const char * vertexShaderSource =
+		"layout (location = 0) in vec3 aPos;\n"
+		"layout (location = 1) in vec4 color;\n"
+
+		"out vec4 vertexColor;\n"
+		
+		"uniform mat4 modelMatrix;\n"
+		"uniform mat4 viewMatrix;\n"
+		"uniform mat4 projectionMatrix;\n"
+
+		"void main()\n"
+		"{\n"
+		"	gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(aPos, 1.0f);\n"
+		"	vertexColor = color;\n"
+		"}\0";
+	const char * fragmentShaderSource =
+		"out vec4 FragColor;\n"
+		"in vec4 vertexColor;\n"
+		"void main()\n"
+		"{\n"
+		"	FragColor = vertexColor;\n"
+		"}\0";
+	// points are quads expanded around their center from the vertex id, size is in pixels
+	const char * pointVertexShaderSource =
+		"layout (location = 0) in vec4 aPosSize;\n"
+		"layout (location = 1) in vec4 color;\n"
+
+		"out vec4 vertexColor;\n"
+
+		"uniform mat4 modelMatrix;\n"
+		"uniform mat4 viewMatrix;\n"
+		"uniform mat4 projectionMatrix;\n"
+		"uniform vec2 pixelSize;\n"
+
+		"void main()\n"
+		"{\n"
+		"	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) - 0.5f;\n"
+		"	gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(aPosSize.xyz, 1.0f);\n"
+		"	gl_Position.xy += corner * aPosSize.w * pixelSize * gl_Position.w;\n"
+		"	vertexColor = color;\n"
+		"}\0";
+
+	// glyphs are quads expanded from the vertex id like points, but sized in world units,
+	// the atlas holds signed distances with the outline at 0.5
+	const char * textVertexShaderSource =
+		"layout (location = 0) in vec3 aPos;\n"
+		"layout (location = 1) in vec2 aSize;\n"
+		"layout (location = 2) in vec4 aUV;\n"
+		"layout (location = 3) in vec4 color;\n"
+
+		"out vec4 vertexColor;\n"
+		"out vec2 uv;\n"
+
+		"uniform mat4 modelMatrix;\n"
+		"uniform mat4 viewMatrix;\n"
+		"uniform mat4 projectionMatrix;\n"
+
+		"void main()\n"
+		"{\n"
+		"	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+		"	gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(aPos.xy + corner * aSize, aPos.z, 1.0f);\n"
+		"	uv = mix(aUV.xy, aUV.zw, corner);\n"
+		"	vertexColor = color;\n"
+		"}\0";
+	const char * textFragmentShaderSource =
+		"out vec4 FragColor;\n"
+		"in vec4 vertexColor;\n"
+		"in vec2 uv;\n"
+		"uniform sampler2D atlas;\n"
+		"void main()\n"
+		"{\n"
+		"	float distance = texture(atlas, uv).r;\n"
+		"	float alpha = clamp((distance - 0.5f) / max(fwidth(distance), 1e-5f) + 0.5f, 0.0f, 1.0f);\n"
+		"	FragColor = vec4(vertexColor.rgb, vertexColor.a * alpha);\n"
+		"}\0";
+
+	m_shader = createProgram(m_caps->glslVersion, vertexShaderSource, fragmentShaderSource);
+	m_pointShader = createProgram(m_caps->glslVersion, pointVertexShaderSource, fragmentShaderSource);
+	m_textShader = createProgram(m_caps->glslVersion, textVertexShaderSource, textFragmentShaderSource);
+	m_appliedShader = 0;
+	useProgram(m_textShader);
+	glUniform1i(glGetUniformLocation(m_textShader, "atlas"), 0);
+
+	m_modelLocation = glGetUniformLocation(m_shader, "modelMatrix");
+	GLDebug::label(GL_PROGRAM, m_shader, "Renderer2D shape program");
+	GLDebug::label(GL_PROGRAM, m_pointShader, "Renderer2D point program");
+	GLDebug::label(GL_PROGRAM, m_textShader, "Renderer2D text program");
 	/* ------------------------------------------------------------------------- */
 
 	// use of vertex array object
@@ -105,8 +247,23 @@ Renderer2D::Renderer2D() {
 	// Allocate space and upload data from CPU to GPU 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * (MAX_SPRITES * 4), m_vertices, GL_STATIC_DRAW);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_indices), m_indices, GL_STATIC_DRAW);
+	m_streamRegion = 0;
+	std::fill(m_streamFences, m_streamFences + STREAM_REGIONS, nullptr);
+	m_mappedVertices = nullptr;
+	m_mappedIndices = nullptr;
+	if (m_caps->bufferStorage) {
+		// one region per flush in flight, mapped once for the life of the renderer,
+		// a fence per region guards against overwriting what the GPU still reads
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_ARRAY_BUFFER, sizeof(m_vertices) * STREAM_REGIONS, nullptr, flags);
+		glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_sortedIndices) * STREAM_REGIONS, nullptr, flags);
+		m_mappedVertices = (Vertex*)glMapBufferRange(GL_ARRAY_BUFFER, 0, sizeof(m_vertices) * STREAM_REGIONS, flags);
+		m_mappedIndices = (unsigned int*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(m_sortedIndices) * STREAM_REGIONS, flags);
+	}
+	else {
+		glBufferData(GL_ARRAY_BUFFER, sizeof(m_vertices), nullptr, GL_STREAM_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_sortedIndices), nullptr, GL_STREAM_DRAW);
+	}
 
 	// position attribute - Specify how the data for position can be accessed 
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (char*)0);
@@ -118,138 +275,101 @@ Renderer2D::Renderer2D() {
 	glEnableVertexAttribArray(1);
 
 	glBindVertexArray(0);
+	GLDebug::label(GL_VERTEX_ARRAY, m_VAO, "Renderer2D stream VAO");
+	GLDebug::label(GL_BUFFER, m_VBO, "Renderer2D stream vertices");
+	GLDebug::label(GL_BUFFER, m_EBO, "Renderer2D stream indices");
+
+	// points are instanced quads, the quad corners come from gl_VertexID
+	glGenVertexArrays(1, &m_pointVAO);
+	glGenBuffers(1, &m_pointVBO);
+	glBindVertexArray(m_pointVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_pointVBO);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(PointInstance), (char*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribDivisor(0, 1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PointInstance), (char*)16);
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
+	glBindVertexArray(0);
+	GLDebug::label(GL_VERTEX_ARRAY, m_pointVAO, "Renderer2D point VAO");
+	GLDebug::label(GL_BUFFER, m_pointVBO, "Renderer2D point instances");
+
+	// glyphs are instanced quads as well, from their own instance buffer
+	glGenVertexArrays(1, &m_textVAO);
+	glGenBuffers(1, &m_textVBO);
+	glBindVertexArray(m_textVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
+	setGlyphAttributes(0);
+	for (unsigned int i = 0; i < 4; ++i) {
+		glEnableVertexAttribArray(i);
+		glVertexAttribDivisor(i, 1);
+	}
+	glBindVertexArray(0);
+	GLDebug::label(GL_VERTEX_ARRAY, m_textVAO, "Renderer2D text VAO");
+	GLDebug::label(GL_BUFFER, m_textVBO, "Renderer2D glyph instances");
+	m_glyphCache = new GlyphCache();
+	m_font = m_glyphCache->getBuiltinFont();
+
+	m_textureLoader = new TextureLoader(m_caps);
+	m_imageDecoder.user = nullptr;
+	m_imageDecoder.decode = TextureLoader::decodeBuiltin;
+
+	m_targetPool = new RenderTargetPool();
+	m_postProcess = new PostProcess(m_caps->glslVersion, m_targetPool);
+	m_sceneTarget = nullptr;
+	m_renderTarget = nullptr;
+	m_defaultPass.colorLoad = LOAD_CLEAR;
+	m_defaultPass.depthLoad = LOAD_CLEAR;
+	m_defaultPass.colorStore = STORE_KEEP;
+	m_defaultPass.depthStore = STORE_DONT_CARE;
+	setClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	m_pass = m_defaultPass;
+
+	m_shapePool = new ShapePool(m_caps->directStateAccess);
+	m_stroker = new Stroke::Stroker();
+	m_strokeFirstVertex = 0;
+	m_strokeFirstIndex = 0;
 }
 
 void Renderer2D::drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3) {
-	// reset the current vertex
-	m_currentVertex = 0;
-	// reset the current index
-	m_currentIndex = 0;
-	// set the startindex to 0
+	float points[] = { x1, y1, x2, y2, x3, y3 };
+	if (!pointsVisible(points, 3, 0.0f)) {
+		return;
+	}
+	beginPrimitive(3, 3);
+	// the primitive starts after the queued vertices and indices
 	int startIndex = m_currentVertex;
+	int firstIndex = m_currentIndex;
 
-	// first point
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x1;
-	m_vertices[m_currentVertex].pos[1] = y1;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
-
-	// second point
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x2;
-	m_vertices[m_currentVertex].pos[1] = y2;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	//color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
-
-	// third point
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x3;
-	m_vertices[m_currentVertex].pos[1] = y3;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
+	addVertex(x1, y1);
+	addVertex(x2, y2);
+	addVertex(x3, y3);
 
 	m_indices[m_currentIndex++] = startIndex;
 	m_indices[m_currentIndex++] = startIndex + 1;
 	m_indices[m_currentIndex++] = startIndex + 2;
 
-
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_currentVertex, m_vertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(int) * m_currentIndex, m_indices);
-
-	glDrawElements(GL_TRIANGLES, m_currentIndex, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0); 
+	submit(GL_TRIANGLES, startIndex, firstIndex);
 }
 
 void Renderer2D::drawPoint(float x1, float y1, float size) {
-	m_vertices[0].pos[0] = x1;
-	m_vertices[0].pos[1] = y1;
-	m_vertices[0].pos[2] = 0.0f;
-
-	m_vertices[0].color[0] = m_r;
-	m_vertices[0].color[1] = m_g;
-	m_vertices[0].color[2] = m_b;
-	m_vertices[0].color[3] = m_a;
-
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex), m_vertices);
-
-	glDrawArrays(GL_POINTS, 0, 1);
-	glPointSize(size);
-	glBindVertexArray(0);
+	Point point = { x1, y1, size, { m_r, m_g, m_b, m_a } };
+	drawPoints(&point, 1);
 }
 
 void Renderer2D::drawRectangle(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4) {
-	// reset the current vertex
-	m_currentVertex = 0;
-	// reset the current index
-	m_currentIndex = 0;
-	// set the startindex to 0
+	float points[] = { x1, y1, x2, y2, x3, y3, x4, y4 };
+	if (!pointsVisible(points, 4, 0.0f)) {
+		return;
+	}
+	beginPrimitive(4, 6);
 	int startIndex = m_currentVertex;
+	int firstIndex = m_currentIndex;
 
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x1;
-	m_vertices[m_currentVertex].pos[1] = y1;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
-
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x2;
-	m_vertices[m_currentVertex].pos[1] = y2;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
-
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x3;
-	m_vertices[m_currentVertex].pos[1] = y3;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
-
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x4;
-	m_vertices[m_currentVertex].pos[1] = y4;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
+	addVertex(x1, y1);
+	addVertex(x2, y2);
+	addVertex(x3, y3);
+	addVertex(x4, y4);
 
 	m_indices[m_currentIndex++] = startIndex + 0;
 	m_indices[m_currentIndex++] = startIndex + 1;
@@ -259,167 +379,1446 @@ void Renderer2D::drawRectangle(float x1, float y1, float x2, float y2, float x3,
 	m_indices[m_currentIndex++] = startIndex + 2;
 	m_indices[m_currentIndex++] = startIndex + 3;
 
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+	submit(GL_TRIANGLES, startIndex, firstIndex);
+}
 
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_currentVertex, m_vertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(int) * m_currentIndex, m_indices);
+void Renderer2D::drawCircle(float x1, float y1, float radius) {
+	Circle circle = { x1, y1, radius, { m_r, m_g, m_b, m_a } };
+	drawCircles(&circle, 1);
+}
 
-	glDrawElements(GL_TRIANGLES, m_currentIndex, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
+void Renderer2D::drawLine(float x1, float y1, float x2, float y2, float width) {
+	float points[] = { x1, y1, x2, y2 };
+	float color[] = { m_r, m_g, m_b, m_a };
+	stroke(points, 2, false, width, color);
 }
 
-void Renderer2D::drawCircle(float x1, float y1, float radius) {
-	// reset the current vertex
-	m_currentVertex = 0;
-	m_currentIndex = 0;
-	// set the startindex to 0
-	int startIndex = m_currentVertex;
+void Renderer2D::drawRects(const Rect* rects, int count) {
+	while (count > 0) {
+		// queue as many rectangles as fit as a single primitive
+		int chunk = glm::min(count, (int)MAX_SPRITES);
+		reservePrimitive(chunk * 4, chunk * 6);
+		int startIndex = m_currentVertex;
+		int firstIndex = m_currentIndex;
 
-	float r = radius;
-	// set p to 0 and Q to radius
-	float p = 0.0f;
-	float q = r;
-	// set the decision parameter
-	float d = 3 - (2 * r);
+		// off screen rectangles are skipped while the vertices are written
+		int written = VertexExpand::rects(m_vertices + m_currentVertex, rects, pendingDepth(), chunk, cullBounds());
+		VertexExpand::rectIndices(m_indices + m_currentIndex, m_currentVertex, written);
+		m_currentVertex += written * 4;
+		m_currentIndex += written * 6;
 
-	// plot the center point
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x1;
-	m_vertices[m_currentVertex].pos[1] = y1;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
-
-	float rotDelta = glm::pi<float>() * 2 / 32;
-
-	for (int i = 0; i < 32; ++i) {
-		// pos
-		m_vertices[m_currentVertex].pos[0] = glm::sin(rotDelta * i) * radius + x1;
-		m_vertices[m_currentVertex].pos[1] = glm::cos(rotDelta * i) * radius + y1;
-		m_vertices[m_currentVertex].pos[2] = 0.0f;
-		// color
-		m_vertices[m_currentVertex].color[0] = m_r;
-		m_vertices[m_currentVertex].color[1] = m_g;
-		m_vertices[m_currentVertex].color[2] = m_b;
-		m_vertices[m_currentVertex].color[3] = m_a;
-		m_currentVertex++;
-
-		if (i == (32 - 1)) {
-			m_indices[m_currentIndex++] = startIndex;
-			m_indices[m_currentIndex++] = startIndex + 1;
-			m_indices[m_currentIndex++] = m_currentVertex - 1;
+		// a chunk culled entirely takes no depth
+		if (written > 0) {
+			nextDepth();
+			submit(GL_TRIANGLES, startIndex, firstIndex);
 		}
-		else {
-			m_indices[m_currentIndex++] = startIndex;
-			m_indices[m_currentIndex++] = m_currentVertex;
-			m_indices[m_currentIndex++] = m_currentVertex - 1;
+		rects += chunk;
+		count -= chunk;
+	}
+}
+
+void Renderer2D::drawRects(const float* x, const float* y, const float* width, const float* height, const float* colors, int count) {
+	float color[] = { m_r, m_g, m_b, m_a };
+	int colorStride = (colors != nullptr ? 4 : 0);
+	if (colors == nullptr) {
+		colors = color;
+	}
+
+	for (int offset = 0; offset < count; ) {
+		int chunk = glm::min(count - offset, (int)MAX_SPRITES);
+		reservePrimitive(chunk * 4, chunk * 6);
+		int startIndex = m_currentVertex;
+		int firstIndex = m_currentIndex;
+
+		int written = VertexExpand::rects(m_vertices + m_currentVertex, x + offset, y + offset, width + offset, height + offset,
+			colors + offset * colorStride, colorStride, pendingDepth(), chunk, cullBounds());
+		VertexExpand::rectIndices(m_indices + m_currentIndex, m_currentVertex, written);
+		m_currentVertex += written * 4;
+		m_currentIndex += written * 6;
+
+		if (written > 0) {
+			nextDepth();
+			submit(GL_TRIANGLES, startIndex, firstIndex);
 		}
+		offset += chunk;
 	}
+}
 
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+void Renderer2D::drawCircles(const Circle* circles, int count) {
+	const int maxCircles = MAX_VERTICES / VertexExpand::CIRCLE_VERTICES;
+	while (count > 0) {
+		int chunk = glm::min(count, maxCircles);
+		reservePrimitive(chunk * VertexExpand::CIRCLE_VERTICES, chunk * VertexExpand::CIRCLE_INDICES);
+		int startIndex = m_currentVertex;
+		int firstIndex = m_currentIndex;
 
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_currentVertex, m_vertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(int) * m_currentIndex, m_indices);
+		int written = VertexExpand::circles(m_vertices + m_currentVertex, circles, pendingDepth(), chunk, cullBounds());
+		VertexExpand::circleIndices(m_indices + m_currentIndex, m_currentVertex, written);
+		m_currentVertex += written * VertexExpand::CIRCLE_VERTICES;
+		m_currentIndex += written * VertexExpand::CIRCLE_INDICES;
 
-	glDrawElements(GL_TRIANGLES, m_currentIndex, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
+		if (written > 0) {
+			nextDepth();
+			submit(GL_TRIANGLES, startIndex, firstIndex);
+		}
+		circles += chunk;
+		count -= chunk;
+	}
 }
 
-void Renderer2D::drawLine(float x1, float y1, float x2, float y2, float width) {
-	// reset the current vertex
-	m_currentVertex = 0;
-	m_currentIndex = 0;
-	// set the startindex to 0
-	int startIndex = m_currentVertex;
-	
-	// plot the points
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x1;
-	m_vertices[m_currentVertex].pos[1] = y1;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
+void Renderer2D::drawCircles(const float* x, const float* y, const float* radius, const float* colors, int count) {
+	const int maxCircles = MAX_VERTICES / VertexExpand::CIRCLE_VERTICES;
+	float color[] = { m_r, m_g, m_b, m_a };
+	int colorStride = (colors != nullptr ? 4 : 0);
+	if (colors == nullptr) {
+		colors = color;
+	}
 
-	// plot the points
-	// pos
-	m_vertices[m_currentVertex].pos[0] = x2;
-	m_vertices[m_currentVertex].pos[1] = y2;
-	m_vertices[m_currentVertex].pos[2] = 0.0f;
-	// color
-	m_vertices[m_currentVertex].color[0] = m_r;
-	m_vertices[m_currentVertex].color[1] = m_g;
-	m_vertices[m_currentVertex].color[2] = m_b;
-	m_vertices[m_currentVertex].color[3] = m_a;
-	m_currentVertex++;
+	for (int offset = 0; offset < count; ) {
+		int chunk = glm::min(count - offset, maxCircles);
+		reservePrimitive(chunk * VertexExpand::CIRCLE_VERTICES, chunk * VertexExpand::CIRCLE_INDICES);
+		int startIndex = m_currentVertex;
+		int firstIndex = m_currentIndex;
 
-	glLineWidth(width);
+		int written = VertexExpand::circles(m_vertices + m_currentVertex, x + offset, y + offset, radius + offset,
+			colors + offset * colorStride, colorStride, pendingDepth(), chunk, cullBounds());
+		VertexExpand::circleIndices(m_indices + m_currentIndex, m_currentVertex, written);
+		m_currentVertex += written * VertexExpand::CIRCLE_VERTICES;
+		m_currentIndex += written * VertexExpand::CIRCLE_INDICES;
 
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		if (written > 0) {
+			nextDepth();
+			submit(GL_TRIANGLES, startIndex, firstIndex);
+		}
+		offset += chunk;
+	}
+}
 
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_currentVertex, m_vertices);
+void Renderer2D::drawLines(const Line* lines, int count) {
+	Stroke::Style style = { 1.0f, m_lineJoin, m_lineCap, pixelsPerUnit() };
+	const int maxLines = glm::min(MAX_VERTICES / Stroke::maxVertices(2), MAX_INDICES / Stroke::maxIndices(2));
+	while (count > 0) {
+		// the lines of a chunk are one primitive, whatever their widths
+		int chunk = glm::min(count, maxLines);
+		reservePrimitive(chunk * Stroke::maxVertices(2), chunk * Stroke::maxIndices(2));
+		int startIndex = m_currentVertex;
+		int firstIndex = m_currentIndex;
+		// the depth is only taken when a line of the chunk is visible
+		float depth = pendingDepth();
 
-	glDrawArrays(GL_LINES, 0, 2);
-	glBindVertexArray(0);
+		for (int i = 0; i < chunk; ++i) {
+			const Line& line = lines[i];
+			float points[] = { line.x1, line.y1, line.x2, line.y2 };
+			if (!pointsVisible(points, 2, line.width * 0.5f * Stroke::MITER_LIMIT)) {
+				continue;
+			}
+			style.width = line.width;
+
+			int vertexCount = 0;
+			int indexCount = 0;
+			Stroke::polyline(m_vertices + m_currentVertex, m_indices + m_currentIndex, m_currentVertex,
+				points, 2, false, style, depth, line.color, vertexCount, indexCount);
+			m_currentVertex += vertexCount;
+			m_currentIndex += indexCount;
+		}
+
+		if (m_currentIndex > firstIndex) {
+			nextDepth();
+			submit(GL_TRIANGLES, startIndex, firstIndex);
+		}
+		lines += chunk;
+		count -= chunk;
+	}
 }
 
-void Renderer2D::SetColor(float r, float g, float b, float a) {
-	m_r = r;
-	m_g = g;
-	m_b = b;
-	m_a = a;
+void Renderer2D::drawPoints(const Point* points, int count) {
+	// baked meshes only hold triangles, so recorded points become quads sized in world units
+	if (m_recording) {
+		while (count > 0) {
+			int chunk = glm::min(count, (int)MAX_SPRITES);
+			beginPrimitive(chunk * 4, chunk * 6);
+			int startIndex = m_currentVertex;
+			int firstIndex = m_currentIndex;
+
+			for (int i = 0; i < chunk; ++i) {
+				const Point& point = points[i];
+				float half = point.size * 0.5f;
+				unsigned int first = (unsigned int)m_currentVertex;
+				addVertex(point.x - half, point.y + half, point.color);
+				addVertex(point.x + half, point.y + half, point.color);
+				addVertex(point.x + half, point.y - half, point.color);
+				addVertex(point.x - half, point.y - half, point.color);
+
+				m_indices[m_currentIndex++] = first + 0;
+				m_indices[m_currentIndex++] = first + 1;
+				m_indices[m_currentIndex++] = first + 2;
+				m_indices[m_currentIndex++] = first + 0;
+				m_indices[m_currentIndex++] = first + 2;
+				m_indices[m_currentIndex++] = first + 3;
+			}
+
+			submit(GL_TRIANGLES, startIndex, firstIndex);
+			points += chunk;
+			count -= chunk;
+		}
+		return;
+	}
+	if (count <= 0) {
+		return;
+	}
+
+	// points only take a depth, their instances are kept apart from the vertices
+	beginPrimitive(0, 0);
+	int first = (int)m_points.size();
+	m_points.resize(m_points.size() + count);
+	int visible = 0;
+	for (int i = 0; i < count; ++i) {
+		// the quad is sized in window units, its half diagonal in world units stays below size / zoom
+		float margin = points[i].size / m_camera.getZoom();
+		if (!isVisible(points[i].x - margin, points[i].y - margin, points[i].x + margin, points[i].y + margin)) {
+			continue;
+		}
+		PointInstance& instance = m_points[first + visible++];
+		instance.pos[0] = points[i].x;
+		instance.pos[1] = points[i].y;
+		instance.pos[2] = m_depth;
+		instance.size = points[i].size;
+		instance.color[0] = points[i].color[0];
+		instance.color[1] = points[i].color[1];
+		instance.color[2] = points[i].color[2];
+		instance.color[3] = points[i].color[3];
+	}
+	m_points.resize(first + visible);
+	if (visible > 0) {
+		queueCommand(PIPELINE_POINTS, first, visible, 0, 0);
+	}
 }
 
-void Renderer2D::begin() {
-	// get the window window width and height
-	int width = 0;
-	int height = 0;
-	GLFWwindow* window = glfwGetCurrentContext();
-	glfwGetWindowSize(window, &width, &height);
+FontHandle Renderer2D::createFont(const FontSource& source) {
+	return m_glyphCache->createFont(source);
+}
 
-	glUseProgram(m_shader);
+void Renderer2D::destroyFont(FontHandle font) {
+	// glyphs of the font may still be queued or held back, they are drawn before the font goes away
+	resolve();
+	m_glyphCache->destroyFont(font);
+	if (m_font == font) {
+		m_font = m_glyphCache->getBuiltinFont();
+	}
+}
 
-	// initializing model identity matrix
-	glm::mat4 model = glm::mat4(1.0f);
-	// initializing view identity matrix
-	glm::mat4 view = glm::mat4(1.0f);
-	// initializing projection identity matrix
-	glm::mat4 projection = glm::mat4(1.0f);
+FontHandle Renderer2D::getBuiltinFont() const {
+	return m_glyphCache->getBuiltinFont();
+}
 
-	model = glm::rotate(model, glm::radians(0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-	view = glm::translate(view, glm::vec3(0.0f, 0.0f, 0.0f));
-	projection = glm::ortho(0.0f, (float)width, 0.0f, (float)height, 1.0f, -101.0f);
+void Renderer2D::setFont(FontHandle font) {
+	m_font = (m_glyphCache->isFont(font) ? font : m_glyphCache->getBuiltinFont());
+}
 
-	// pass the matrices into shader
-	glUniformMatrix4fv(glGetUniformLocation(m_shader, "modelMatrix"), 1, GL_FALSE, glm::value_ptr(model));
-	glUniformMatrix4fv(glGetUniformLocation(m_shader, "viewMatrix"), 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(glGetUniformLocation(m_shader, "projectionMatrix"), 1, GL_FALSE, glm::value_ptr(projection));
+void Renderer2D::drawText(float x, float y, const char* text, float size) {
+	if (m_recording || text == nullptr || *text == '\0') {
+		return;
+	}
+	const GlyphCache::Layout& layout = m_glyphCache->layout(m_font, text, m_frame);
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// the bounds cover the pen positions, glyphs reach a little past them
+	float margin = 0.25f * size;
+	if (!isVisible(x + layout.bounds[0] * size - margin, y + layout.bounds[1] * size - margin,
+		x + layout.bounds[2] * size + margin, y + layout.bounds[3] * size + margin)) {
+		return;
+	}
 
-	SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+	// glyph edges are blended, so opaque text is queued as alpha blended
+	BlendMode blendMode = m_blendMode;
+	if (m_blendMode == BLEND_OPAQUE) {
+		m_blendMode = BLEND_ALPHA;
+	}
+	beginPrimitive(0, 0);
+	int first = (int)m_glyphs.size();
+	for (size_t i = 0; i < layout.glyphs.size(); ++i) {
+		const GlyphCache::PlacedGlyph& placed = layout.glyphs[i];
+		const GlyphCache::Entry* entry = m_glyphCache->find(m_font, placed.codepoint, m_frame);
+		if (entry == nullptr) {
+			// every cell holds a glyph of this frame, draw them before one is replaced
+			if (m_glyphCache->isFull(m_frame)) {
+				if ((int)m_glyphs.size() > first) {
+					queueCommand(PIPELINE_TEXT, first, (int)m_glyphs.size() - first, 0, 0);
+				}
+				resolve();
+				first = 0;
+			}
+			entry = &m_glyphCache->load(m_font, placed.codepoint, m_frame);
+		}
+		if (entry->cell < 0) {
+			continue;
+		}
+
+		GlyphInstance instance;
+		instance.pos[0] = x + (placed.x + entry->quad[0]) * size;
+		instance.pos[1] = y + (placed.y + entry->quad[1]) * size;
+		instance.pos[2] = m_depth;
+		instance.size[0] = (entry->quad[2] - entry->quad[0]) * size;
+		instance.size[1] = (entry->quad[3] - entry->quad[1]) * size;
+		std::copy(entry->uv, entry->uv + 4, instance.uv);
+		instance.color[0] = m_r;
+		instance.color[1] = m_g;
+		instance.color[2] = m_b;
+		instance.color[3] = m_a;
+		m_glyphs.push_back(instance);
+	}
+	if ((int)m_glyphs.size() > first) {
+		queueCommand(PIPELINE_TEXT, first, (int)m_glyphs.size() - first, 0, 0);
+	}
+	m_blendMode = blendMode;
 }
 
-void Renderer2D::end() {
-	glDeleteProgram(m_shader);
+void Renderer2D::measureText(const char* text, float size, float& width, float& height) {
+	width = 0.0f;
+	height = 0.0f;
+	if (text == nullptr || *text == '\0') {
+		return;
+	}
+	const GlyphCache::Layout& layout = m_glyphCache->layout(m_font, text, m_frame);
+	width = (layout.bounds[2] - layout.bounds[0]) * size;
+	height = (layout.bounds[3] - layout.bounds[1]) * size;
 }
 
-Renderer2D::~Renderer2D() {
-	glDeleteVertexArrays(1, &m_VAO);
-	glDeleteBuffers(1, &m_VBO);
-	glDeleteBuffers(1, &m_EBO);
+void Renderer2D::drawTriangles(const Triangle* triangles, int count) {
+	while (count > 0) {
+		int chunk = glm::min(count, (int)MAX_SPRITES);
+		beginPrimitive(chunk * 3, chunk * 3);
+		int startIndex = m_currentVertex;
+		int firstIndex = m_currentIndex;
+
+		for (int i = 0; i < chunk; ++i) {
+			const Triangle& triangle = triangles[i];
+			if (!pointsVisible(triangle.points, 3, 0.0f)) {
+				continue;
+			}
+
+			for (int j = 0; j < 3; ++j) {
+				m_indices[m_currentIndex++] = m_currentVertex;
+				addVertex(triangle.points[j * 2 + 0], triangle.points[j * 2 + 1], triangle.color);
+			}
+		}
+
+		if (m_currentIndex > firstIndex) {
+			submit(GL_TRIANGLES, startIndex, firstIndex);
+		}
+		triangles += chunk;
+		count -= chunk;
+	}
+}
+
+void Renderer2D::drawPolyline(const float* points, int count, float width, bool closed) {
+	// a streamed polyline is only known point by point, a whole one is culled up front
+	if (!pointsVisible(points, count, width * 0.5f * Stroke::MITER_LIMIT)) {
+		return;
+	}
+	beginPolyline(width, closed);
+	addPolylinePoints(points, count);
+	endPolyline();
+}
+
+void Renderer2D::beginPolyline(float width, bool closed) {
+	Stroke::Style style = { width, m_lineJoin, m_lineCap, pixelsPerUnit() };
+	m_stroker->begin(style, closed);
+	m_strokeColor[0] = m_r;
+	m_strokeColor[1] = m_g;
+	m_strokeColor[2] = m_b;
+	m_strokeColor[3] = m_a;
+	beginStroke();
+}
+
+void Renderer2D::addPolylinePoints(const float* points, int count) {
+	for (int i = 0; i < count; ) {
+		// points that still fit, leaving room for the end of the polyline
+		int room = glm::min((MAX_VERTICES - m_currentVertex - Stroke::END_VERTICES) / Stroke::POINT_VERTICES,
+			(MAX_INDICES - m_currentIndex - Stroke::END_INDICES) / Stroke::POINT_INDICES);
+		if (room <= 0) {
+			// continue in a new primitive, which flushes the full queue
+			submitStroke();
+			beginStroke();
+			continue;
+		}
+
+		int chunk = glm::min(count - i, room);
+		for (int j = i; j < i + chunk; ++j) {
+			m_stroker->addPoint(points[j * 2 + 0], points[j * 2 + 1]);
+		}
+		m_currentVertex = m_strokeFirstVertex + m_stroker->getOutput().vertexCount;
+		m_currentIndex = m_strokeFirstIndex + m_stroker->getOutput().indexCount;
+		i += chunk;
+	}
+}
+
+void Renderer2D::endPolyline() {
+	m_stroker->end();
+	m_currentVertex = m_strokeFirstVertex + m_stroker->getOutput().vertexCount;
+	m_currentIndex = m_strokeFirstIndex + m_stroker->getOutput().indexCount;
+	submitStroke();
+}
+
+void Renderer2D::beginStroke() {
+	// the carried edge, one point and the end of the polyline always fit
+	beginPrimitive(2 + Stroke::POINT_VERTICES + Stroke::END_VERTICES, Stroke::POINT_INDICES + Stroke::END_INDICES);
+	m_strokeFirstVertex = m_currentVertex;
+	m_strokeFirstIndex = m_currentIndex;
+
+	Stroke::Output output = { m_vertices + m_currentVertex, m_indices + m_currentIndex, (unsigned int)m_currentVertex,
+		m_depth, m_strokeColor, 0, 0 };
+	m_stroker->setOutput(output);
+	m_currentVertex += m_stroker->getOutput().vertexCount;
+}
+
+void Renderer2D::submitStroke() {
+	if (m_currentIndex > m_strokeFirstIndex) {
+		submit(GL_TRIANGLES, m_strokeFirstVertex, m_strokeFirstIndex);
+	}
+}
+
+void Renderer2D::stroke(const float* points, int count, bool closed, float width, const float* color) {
+	// miters reach at most MITER_LIMIT half widths past the points, further than any cap
+	if (!pointsVisible(points, count, width * 0.5f * Stroke::MITER_LIMIT)) {
+		return;
+	}
+
+	beginPrimitive(Stroke::maxVertices(count), Stroke::maxIndices(count));
+	int startIndex = m_currentVertex;
+	int firstIndex = m_currentIndex;
+
+	Stroke::Style style = { width, m_lineJoin, m_lineCap, pixelsPerUnit() };
+	int vertexCount = 0;
+	int indexCount = 0;
+	Stroke::polyline(m_vertices + m_currentVertex, m_indices + m_currentIndex, m_currentVertex,
+		points, count, closed, style, m_depth, color, vertexCount, indexCount);
+	m_currentVertex += vertexCount;
+	m_currentIndex += indexCount;
+
+	if (indexCount > 0) {
+		submit(GL_TRIANGLES, startIndex, firstIndex);
+	}
+}
+
+void Renderer2D::drawPolygon(const float* points, int count, const int* ringSizes, int ringCount) {
+	if (ringSizes == nullptr) {
+		ringSizes = &count;
+		ringCount = 1;
+	}
+	if (!checkRings(count, ringSizes, ringCount)) {
+		return;
+	}
+	// culled before the hash, so off screen polygons are neither hashed nor clipped
+	if (!pointsVisible(points, count, 0.0f)) {
+		return;
+	}
+
+	unsigned long long key = Triangulate::hash(points, count, ringSizes, ringCount);
+	std::unordered_map<unsigned long long, CachedPolygon>::iterator it = m_polygonCache.find(key);
+	if (it == m_polygonCache.end()) {
+		it = m_polygonCache.insert(std::make_pair(key, CachedPolygon())).first;
+	}
+	CachedPolygon& cached = it->second;
+	// a hit needs the same rings and points, another polygon with the same hash replaces the entry
+	if (cached.ringSizes.size() != (size_t)ringCount || cached.points.size() != (size_t)count * 2 ||
+		!std::equal(ringSizes, ringSizes + ringCount, cached.ringSizes.begin()) ||
+		!std::equal(points, points + count * 2, cached.points.begin())) {
+		cached.points.assign(points, points + count * 2);
+		cached.ringSizes.assign(ringSizes, ringSizes + ringCount);
+		cached.indices.clear();
+		Triangulate::earClip(points, ringSizes, ringCount, cached.indices);
+	}
+	cached.lastFrame = m_frame;
+
+	fillPolygon(points, count, cached.indices, 0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+PolygonHandle Renderer2D::createPolygon(const float* points, int count, const int* ringSizes, int ringCount) {
+	if (ringSizes == nullptr) {
+		ringSizes = &count;
+		ringCount = 1;
+	}
+	if (!checkRings(count, ringSizes, ringCount)) {
+		return 0;
+	}
+
+	Polygon polygon;
+	polygon.points.assign(points, points + count * 2);
+	Triangulate::earClip(points, ringSizes, ringCount, polygon.indices);
+	polygon.radius = 0.0f;
+	for (int i = 0; i < count; ++i) {
+		polygon.radius = glm::max(polygon.radius, glm::length(glm::vec2(points[i * 2 + 0], points[i * 2 + 1])));
+	}
+
+	for (size_t i = 0; i < m_polygons.size(); ++i) {
+		if (m_polygons[i].points.empty()) {
+			m_polygons[i].points.swap(polygon.points);
+			m_polygons[i].indices.swap(polygon.indices);
+			m_polygons[i].radius = polygon.radius;
+			return (PolygonHandle)(i + 1);
+		}
+	}
+	m_polygons.push_back(polygon);
+	return (PolygonHandle)m_polygons.size();
+}
+
+void Renderer2D::drawPolygon(PolygonHandle polygon, float x, float y, float rotation, float scale) {
+	if (polygon == 0 || polygon > m_polygons.size() || m_polygons[polygon - 1].points.empty()) {
+		return;
+	}
+	const Polygon& created = m_polygons[polygon - 1];
+	float radius = created.radius * glm::abs(scale);
+	if (!isVisible(x - radius, y - radius, x + radius, y + radius)) {
+		return;
+	}
+	fillPolygon(created.points.data(), (int)created.points.size() / 2, created.indices, x, y, rotation, scale);
+}
+
+void Renderer2D::destroyPolygon(PolygonHandle polygon) {
+	if (polygon == 0 || polygon > m_polygons.size()) {
+		return;
+	}
+	std::vector<float>().swap(m_polygons[polygon - 1].points);
+	std::vector<unsigned int>().swap(m_polygons[polygon - 1].indices);
+}
+
+void Renderer2D::fillPolygon(const float* points, int count, const std::vector<unsigned int>& indices,
+	float x, float y, float rotation, float scale) {
+	int indexCount = (int)indices.size();
+	// polygons larger than the queue cannot be drawn as one primitive
+	if (indexCount == 0 || count > MAX_VERTICES || indexCount > MAX_INDICES) {
+		return;
+	}
+
+	beginPrimitive(count, indexCount);
+	int startIndex = m_currentVertex;
+	int firstIndex = m_currentIndex;
+
+	float c = glm::cos(rotation) * scale;
+	float s = glm::sin(rotation) * scale;
+	for (int i = 0; i < count; ++i) {
+		float px = points[i * 2 + 0];
+		float py = points[i * 2 + 1];
+		addVertex(x + px * c - py * s, y + px * s + py * c);
+	}
+	for (int i = 0; i < indexCount; ++i) {
+		m_indices[m_currentIndex++] = startIndex + indices[i];
+	}
+
+	submit(GL_TRIANGLES, startIndex, firstIndex);
+}
+
+const float* Renderer2D::cullBounds() const {
+	return (m_recording ? nullptr : m_camera.getVisibleBounds());
+}
+
+bool Renderer2D::isVisible(float minX, float minY, float maxX, float maxY) const {
+	const float* bounds = cullBounds();
+	return bounds == nullptr || (maxX >= bounds[0] && maxY >= bounds[1] && minX <= bounds[2] && minY <= bounds[3]);
+}
+
+bool Renderer2D::pointsVisible(const float* points, int count, float margin) const {
+	if (count <= 0 || cullBounds() == nullptr) {
+		return count > 0;
+	}
+	float minX = points[0], minY = points[1];
+	float maxX = minX, maxY = minY;
+	for (int i = 1; i < count; ++i) {
+		minX = glm::min(minX, points[i * 2 + 0]);
+		maxX = glm::max(maxX, points[i * 2 + 0]);
+		minY = glm::min(minY, points[i * 2 + 1]);
+		maxY = glm::max(maxY, points[i * 2 + 1]);
+	}
+	return isVisible(minX - margin, minY - margin, maxX + margin, maxY + margin);
+}
+
+float Renderer2D::pixelsPerUnit() const {
+	// the camera works in window units, a HiDPI framebuffer has more pixels per unit
+	return m_camera.getZoom() * glm::max(m_contentScaleX, m_contentScaleY);
+}
+
+void Renderer2D::addVertex(float x, float y) {
+	Vertex& v = m_vertices[m_currentVertex++];
+	// pos
+	v.pos[0] = x;
+	v.pos[1] = y;
+	v.pos[2] = m_depth;
+	// color
+	v.color[0] = m_r;
+	v.color[1] = m_g;
+	v.color[2] = m_b;
+	v.color[3] = m_a;
+}
+
+void Renderer2D::addVertex(float x, float y, const float* color) {
+	Vertex& v = m_vertices[m_currentVertex++];
+	v.pos[0] = x;
+	v.pos[1] = y;
+	v.pos[2] = m_depth;
+	v.color[0] = color[0];
+	v.color[1] = color[1];
+	v.color[2] = color[2];
+	v.color[3] = color[3];
+}
+
+void Renderer2D::beginPrimitive(int vertexCount, int indexCount) {
+	reservePrimitive(vertexCount, indexCount);
+	nextDepth();
+}
+
+void Renderer2D::reservePrimitive(int vertexCount, int indexCount) {
+	// draw what is queued when the primitive would not fit
+	if (m_currentVertex + vertexCount > MAX_VERTICES || m_currentIndex + indexCount > MAX_INDICES) {
+		flush();
+	}
+}
+
+void Renderer2D::nextDepth() {
+	m_depthKey = pendingDepthKey();
+	m_depth = pendingDepth();
+	m_layerPrimitives[m_layer]++;
+}
+
+unsigned int Renderer2D::pendingDepthKey() const {
+	// every primitive of the frame gets its own depth, higher layers and
+	// later primitives within a layer are closer to the camera
+	int sequence = glm::min(m_layerPrimitives[m_layer], (int)LAYER_STEPS - 1);
+	return (unsigned int)(MAX_LAYERS - 1 - m_layer) * LAYER_STEPS + (LAYER_STEPS - 1 - sequence);
+}
+
+float Renderer2D::pendingDepth() const {
+	return (float)pendingDepthKey() * (MAX_DEPTH / (float)(MAX_LAYERS * LAYER_STEPS));
+}
+
+unsigned long long Renderer2D::makeKey(unsigned int pipeline, unsigned int texture) const {
+	return SortKey::make(pipeline, texture, m_blendMode, m_layer, m_depthKey, m_sequence);
+}
+
+void Renderer2D::submit(unsigned int mode, int firstVertex, int firstIndex) {
+	int indexCount = m_currentIndex - firstIndex;
+
+	// while recording, the primitive is moved into the static mesh instead of queued
+	if (m_recording) {
+		unsigned int base = (unsigned int)m_staticVertices.size();
+		unsigned int first = (unsigned int)m_staticIndices.size();
+		m_staticVertices.insert(m_staticVertices.end(), m_vertices + firstVertex, m_vertices + m_currentVertex);
+		for (int i = firstIndex; i < m_currentIndex; ++i) {
+			m_staticIndices.push_back(base + m_indices[i] - firstVertex);
+		}
+
+		// extend the last range when the primitive needs no state change
+		if (!m_staticRanges.empty() && m_staticRanges.back().mode == mode) {
+			m_staticRanges.back().count += indexCount;
+		}
+		else {
+			MeshRange range = { mode, first, (unsigned int)indexCount };
+			m_staticRanges.push_back(range);
+		}
+
+		m_currentVertex = firstVertex;
+		m_currentIndex = firstIndex;
+		return;
+	}
+
+	queueCommand(PIPELINE_TRIANGLES, firstIndex, indexCount, firstVertex, m_currentVertex - firstVertex);
+}
+
+void Renderer2D::queueCommand(unsigned int pipeline, int first, int count, int firstVertex, int vertexCount) {
+	Command command;
+	command.key = makeKey(pipeline, 0);
+	command.first = first;
+	command.count = count;
+	command.firstVertex = firstVertex;
+	command.vertexCount = vertexCount;
+	command.pipeline = pipeline;
+	command.blendMode = m_blendMode;
+	m_commands.push_back(command);
+	++m_sequence;
+}
+
+void Renderer2D::setGlyphAttributes(int firstInstance) {
+	const char* base = (char*)0 + firstInstance * sizeof(GlyphInstance);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), base + offsetof(GlyphInstance, pos));
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), base + offsetof(GlyphInstance, size));
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), base + offsetof(GlyphInstance, uv));
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), base + offsetof(GlyphInstance, color));
+}
+
+void Renderer2D::useProgram(unsigned int program) {
+	if (m_appliedShader != program) {
+		glUseProgram(program);
+		m_appliedShader = program;
+	}
+}
+
+void Renderer2D::applyBlendMode(int blendMode) {
+	if (blendMode == m_appliedBlendMode) {
+		return;
+	}
+	m_appliedBlendMode = blendMode;
+
+	// only opaque primitives write depth, translucent ones are still tested against it
+	glDepthMask(blendMode == BLEND_OPAQUE ? GL_TRUE : GL_FALSE);
+
+	switch (blendMode) {
+	case BLEND_OPAQUE:
+		glDisable(GL_BLEND);
+		break;
+	case BLEND_ADDITIVE:
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+		break;
+	default:
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		break;
+	}
+}
+
+void Renderer2D::flush() {
+	deferTranslucent();
+	drawQueued();
+}
+
+void Renderer2D::resolve() {
+	if (m_deferredCommands.empty()) {
+		drawQueued();
+		return;
+	}
+
+	// the opaque primitives go first, then everything translucent of the frame in key order
+	deferTranslucent();
+	drawQueued();
+
+	size_t count = m_deferredCommands.size();
+	m_sortKeys.resize(count);
+	m_sortValues.resize(count);
+	m_sortTmpKeys.resize(count);
+	m_sortTmpValues.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		m_sortKeys[i] = m_deferredCommands[i].key;
+		m_sortValues[i] = (unsigned int)i;
+	}
+	SortKey::radixSort(m_sortKeys.data(), m_sortValues.data(), m_sortTmpKeys.data(), m_sortTmpValues.data(), count);
+	m_sortedDeferred.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		m_sortedDeferred[i] = m_deferredCommands[m_sortValues[i]];
+	}
+
+	// queued again in key order and drawn whenever the queue is full,
+	// each draw keeps the order since the keys of a run are already sorted
+	for (size_t i = 0; i < count; ++i) {
+		Command command = m_sortedDeferred[i];
+		if (command.pipeline == PIPELINE_POINTS) {
+			command.first = (int)m_points.size();
+			m_points.insert(m_points.end(), m_deferredPoints.begin() + m_sortedDeferred[i].first,
+				m_deferredPoints.begin() + m_sortedDeferred[i].first + command.count);
+		}
+		else if (command.pipeline == PIPELINE_TEXT) {
+			command.first = (int)m_glyphs.size();
+			m_glyphs.insert(m_glyphs.end(), m_deferredGlyphs.begin() + m_sortedDeferred[i].first,
+				m_deferredGlyphs.begin() + m_sortedDeferred[i].first + command.count);
+		}
+		else {
+			if (m_currentVertex + command.vertexCount > MAX_VERTICES || m_currentIndex + command.count > MAX_INDICES) {
+				drawQueued();
+			}
+			std::copy(m_deferredVertices.begin() + command.firstVertex,
+				m_deferredVertices.begin() + command.firstVertex + command.vertexCount, m_vertices + m_currentVertex);
+			for (int j = 0; j < command.count; ++j) {
+				m_indices[m_currentIndex + j] = m_deferredIndices[command.first + j] - command.firstVertex + m_currentVertex;
+			}
+			command.first = m_currentIndex;
+			command.firstVertex = m_currentVertex;
+			m_currentVertex += command.vertexCount;
+			m_currentIndex += command.count;
+		}
+		m_commands.push_back(command);
+	}
+	drawQueued();
+
+	m_deferredCommands.clear();
+	m_deferredVertices.clear();
+	m_deferredIndices.clear();
+	m_deferredPoints.clear();
+	m_deferredGlyphs.clear();
+}
+
+void Renderer2D::deferTranslucent() {
+	size_t kept = 0;
+	for (size_t i = 0; i < m_commands.size(); ++i) {
+		const Command& command = m_commands[i];
+		if (command.blendMode == BLEND_OPAQUE) {
+			m_commands[kept++] = command;
+			continue;
+		}
+
+		// the data is copied as it is, with the indices made relative to the held back vertices
+		Command deferred = command;
+		if (command.pipeline == PIPELINE_POINTS) {
+			deferred.first = (int)m_deferredPoints.size();
+			m_deferredPoints.insert(m_deferredPoints.end(), m_points.begin() + command.first, m_points.begin() + command.first + command.count);
+		}
+		else if (command.pipeline == PIPELINE_TEXT) {
+			deferred.first = (int)m_deferredGlyphs.size();
+			m_deferredGlyphs.insert(m_deferredGlyphs.end(), m_glyphs.begin() + command.first, m_glyphs.begin() + command.first + command.count);
+		}
+		else {
+			deferred.first = (int)m_deferredIndices.size();
+			deferred.firstVertex = (int)m_deferredVertices.size();
+			m_deferredVertices.insert(m_deferredVertices.end(), m_vertices + command.firstVertex, m_vertices + command.firstVertex + command.vertexCount);
+			for (int j = 0; j < command.count; ++j) {
+				m_deferredIndices.push_back(m_indices[command.first + j] - command.firstVertex + deferred.firstVertex);
+			}
+		}
+		m_deferredCommands.push_back(deferred);
+	}
+	m_commands.resize(kept);
+}
+
+void Renderer2D::drawQueued() {
+	size_t count = m_commands.size();
+	if (count == 0) {
+		m_points.clear();
+		m_glyphs.clear();
+		m_currentVertex = 0;
+		m_currentIndex = 0;
+		return;
+	}
+
+	m_sortKeys.resize(count);
+	m_sortValues.resize(count);
+	m_sortTmpKeys.resize(count);
+	m_sortTmpValues.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		m_sortKeys[i] = m_commands[i].key;
+		m_sortValues[i] = (unsigned int)i;
+	}
+	SortKey::radixSort(m_sortKeys.data(), m_sortValues.data(), m_sortTmpKeys.data(), m_sortTmpValues.data(), count);
+
+	// gather the indices and point instances in key order and cut them into runs that share all draw state
+	m_batches.clear();
+	m_sortedPoints.resize(m_points.size());
+	m_sortedGlyphs.resize(m_glyphs.size());
+	int sortedIndex = 0;
+	int sortedPoint = 0;
+	int sortedGlyph = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const Command& command = m_commands[m_sortValues[i]];
+
+		if (m_batches.empty() || m_batches.back().pipeline != command.pipeline || m_batches.back().blendMode != command.blendMode) {
+			int first = (command.pipeline == PIPELINE_POINTS ? sortedPoint : command.pipeline == PIPELINE_TEXT ? sortedGlyph : sortedIndex);
+			Batch batch = { command.pipeline, command.blendMode, first, 0 };
+			m_batches.push_back(batch);
+		}
+		if (command.pipeline == PIPELINE_POINTS) {
+			std::copy(m_points.begin() + command.first, m_points.begin() + command.first + command.count, m_sortedPoints.begin() + sortedPoint);
+			sortedPoint += command.count;
+		}
+		else if (command.pipeline == PIPELINE_TEXT) {
+			std::copy(m_glyphs.begin() + command.first, m_glyphs.begin() + command.first + command.count, m_sortedGlyphs.begin() + sortedGlyph);
+			sortedGlyph += command.count;
+		}
+		else {
+			std::copy(m_indices + command.first, m_indices + command.first + command.count, m_sortedIndices + sortedIndex);
+			sortedIndex += command.count;
+		}
+		m_batches.back().count += command.count;
+	}
+
+	glBindVertexArray(m_VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+	// where this flush starts in the streaming buffers
+	int baseVertex = 0;
+	int baseIndex = 0;
+	if (m_mappedVertices != nullptr) {
+		// copy into the next mapped region once the GPU is done with it
+		waitStreamRegion();
+		baseVertex = m_streamRegion * MAX_VERTICES;
+		baseIndex = m_streamRegion * MAX_INDICES;
+		std::copy(m_vertices, m_vertices + m_currentVertex, m_mappedVertices + baseVertex);
+		std::copy(m_sortedIndices, m_sortedIndices + sortedIndex, m_mappedIndices + baseIndex);
+	}
+	else {
+		// orphan the buffers so the driver does not wait for the previous flush
+		glBufferData(GL_ARRAY_BUFFER, sizeof(m_vertices), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_currentVertex, m_vertices);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_sortedIndices), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(unsigned int) * sortedIndex, m_sortedIndices);
+	}
+	if (sortedPoint > 0) {
+		glBindBuffer(GL_ARRAY_BUFFER, m_pointVBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(PointInstance) * sortedPoint, m_sortedPoints.data(), GL_STREAM_DRAW);
+	}
+	if (sortedGlyph > 0) {
+		glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(GlyphInstance) * sortedGlyph, m_sortedGlyphs.data(), GL_STREAM_DRAW);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_glyphCache->getTexture());
+	}
+
+	for (size_t i = 0; i < m_batches.size(); ++i) {
+		const Batch& batch = m_batches[i];
+		applyBlendMode(batch.blendMode);
+
+		if (batch.pipeline == PIPELINE_POINTS) {
+			// one quad, as a 4 vertex strip, per point
+			useProgram(m_pointShader);
+			glBindVertexArray(m_pointVAO);
+			if (m_caps->baseInstance) {
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, batch.count, batch.first);
+			}
+			else {
+				// without base instance the attributes are pointed at the first instance of the batch
+				glBindBuffer(GL_ARRAY_BUFFER, m_pointVBO);
+				glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(PointInstance), (char*)0 + batch.first * sizeof(PointInstance));
+				glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PointInstance), (char*)16 + batch.first * sizeof(PointInstance));
+				glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, batch.count);
+			}
+		}
+		else if (batch.pipeline == PIPELINE_TEXT) {
+			// one quad per glyph, all from the one atlas
+			useProgram(m_textShader);
+			glBindVertexArray(m_textVAO);
+			if (m_caps->baseInstance) {
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, batch.count, batch.first);
+			}
+			else {
+				glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
+				setGlyphAttributes(batch.first);
+				glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, batch.count);
+			}
+		}
+		else {
+			useProgram(m_shader);
+			glBindVertexArray(m_VAO);
+			glDrawElementsBaseVertex(GL_TRIANGLES, batch.count, GL_UNSIGNED_INT,
+				(char*)0 + (baseIndex + batch.first) * sizeof(unsigned int), baseVertex);
+		}
+	}
+	glBindVertexArray(0);
+
+	if (m_mappedVertices != nullptr) {
+		// the region is free again once the GPU has run these draws
+		m_streamFences[m_streamRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_streamRegion = (m_streamRegion + 1) % STREAM_REGIONS;
+	}
+
+	m_commands.clear();
+	m_points.clear();
+	m_glyphs.clear();
+	m_currentVertex = 0;
+	m_currentIndex = 0;
+}
+
+void Renderer2D::waitStreamRegion() {
+	GLsync fence = (GLsync)m_streamFences[m_streamRegion];
+	if (fence == nullptr) {
+		return;
+	}
+	// flush on the first wait so the fence is sure to signal
+	GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	while (glClientWaitSync(fence, flags, 1000000000) == GL_TIMEOUT_EXPIRED) {
+		flags = 0;
+	}
+	glDeleteSync(fence);
+	m_streamFences[m_streamRegion] = nullptr;
+}
+
+void Renderer2D::setLayer(int layer) {
+	m_layer = glm::clamp(layer, 0, MAX_LAYERS - 1);
+}
+
+void Renderer2D::setBlendMode(BlendMode blendMode) {
+	m_blendMode = blendMode;
+}
+
+void Renderer2D::setLineJoin(LineJoin join) {
+	m_lineJoin = join;
+}
+
+void Renderer2D::setLineCap(LineCap cap) {
+	m_lineCap = cap;
+}
+
+void Renderer2D::beginStatic() {
+	m_recording = true;
+	m_staticVertices.clear();
+	m_staticIndices.clear();
+	m_staticRanges.clear();
+}
+
+MeshHandle Renderer2D::endStatic() {
+	m_recording = false;
+	if (m_staticIndices.empty()) {
+		return 0;
+	}
+
+	StaticMesh mesh;
+	mesh.ranges = m_staticRanges;
+	mesh.radius = 0.0f;
+	for (size_t i = 0; i < m_staticVertices.size(); ++i) {
+		mesh.radius = glm::max(mesh.radius, glm::length(glm::vec2(m_staticVertices[i].pos[0], m_staticVertices[i].pos[1])));
+	}
+
+	GLsizeiptr vertexBytes = sizeof(Vertex) * m_staticVertices.size();
+	GLsizeiptr indexBytes = sizeof(unsigned int) * m_staticIndices.size();
+	if (m_caps->directStateAccess) {
+		// immutable storage set up without touching the bindings
+		glCreateVertexArrays(1, &mesh.VAO);
+		glCreateBuffers(1, &mesh.VBO);
+		glCreateBuffers(1, &mesh.EBO);
+		glNamedBufferStorage(mesh.VBO, vertexBytes, m_staticVertices.data(), 0);
+		glNamedBufferStorage(mesh.EBO, indexBytes, m_staticIndices.data(), 0);
+
+		glVertexArrayVertexBuffer(mesh.VAO, 0, mesh.VBO, 0, sizeof(Vertex));
+		glVertexArrayElementBuffer(mesh.VAO, mesh.EBO);
+		glEnableVertexArrayAttrib(mesh.VAO, 0);
+		glVertexArrayAttribFormat(mesh.VAO, 0, 3, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(mesh.VAO, 0, 0);
+		glEnableVertexArrayAttrib(mesh.VAO, 1);
+		glVertexArrayAttribFormat(mesh.VAO, 1, 4, GL_FLOAT, GL_FALSE, 12);
+		glVertexArrayAttribBinding(mesh.VAO, 1, 0);
+	}
+	else {
+		glGenVertexArrays(1, &mesh.VAO);
+		glGenBuffers(1, &mesh.VBO);
+		glGenBuffers(1, &mesh.EBO);
+
+		glBindVertexArray(mesh.VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+
+		// the mesh never changes, so use immutable storage where it is available
+		if (m_caps->bufferStorage) {
+			glBufferStorage(GL_ARRAY_BUFFER, vertexBytes, m_staticVertices.data(), 0);
+			glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexBytes, m_staticIndices.data(), 0);
+		}
+		else {
+			glBufferData(GL_ARRAY_BUFFER, vertexBytes, m_staticVertices.data(), GL_STATIC_DRAW);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, m_staticIndices.data(), GL_STATIC_DRAW);
+		}
+
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (char*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (char*)12);
+		glEnableVertexAttribArray(1);
+
+		glBindVertexArray(0);
+	}
+
+	GLDebug::label(GL_VERTEX_ARRAY, mesh.VAO, "Renderer2D static mesh VAO");
+	GLDebug::label(GL_BUFFER, mesh.VBO, "Renderer2D static mesh vertices");
+	GLDebug::label(GL_BUFFER, mesh.EBO, "Renderer2D static mesh indices");
+
+	// the recording buffers are only needed again by the next beginStatic
+	m_staticVertices.clear();
+	m_staticIndices.clear();
+	m_staticRanges.clear();
+
+	for (size_t i = 0; i < m_staticMeshes.size(); ++i) {
+		if (m_staticMeshes[i].VAO == 0) {
+			m_staticMeshes[i] = mesh;
+			return (MeshHandle)(i + 1);
+		}
+	}
+	m_staticMeshes.push_back(mesh);
+	return (MeshHandle)m_staticMeshes.size();
+}
+
+void Renderer2D::drawStatic(MeshHandle mesh, float x, float y, float rotation, float scale) {
+	if (mesh == 0 || mesh > m_staticMeshes.size() || m_staticMeshes[mesh - 1].VAO == 0) {
+		return;
+	}
+	const StaticMesh& staticMesh = m_staticMeshes[mesh - 1];
+	float radius = staticMesh.radius * glm::abs(scale);
+	if (!isVisible(x - radius, y - radius, x + radius, y + radius)) {
+		return;
+	}
+	// opaque meshes are depth tested like one primitive of the current layer,
+	// translucent ones are blended over everything queued before them
+	if (m_blendMode != BLEND_OPAQUE) {
+		resolve();
+	}
+	nextDepth();
+	useProgram(m_shader);
+	applyBlendMode(m_blendMode);
+
+	// the recorded z is replaced by the depth of the mesh
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, m_depth));
+	model = glm::rotate(model, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+	model = glm::scale(model, glm::vec3(scale, scale, 0.0f));
+	glUniformMatrix4fv(m_modelLocation, 1, GL_FALSE, glm::value_ptr(model));
+
+	glBindVertexArray(staticMesh.VAO);
+	for (size_t i = 0; i < staticMesh.ranges.size(); ++i) {
+		const MeshRange& range = staticMesh.ranges[i];
+		glDrawElements(range.mode, range.count, GL_UNSIGNED_INT, (char*)0 + range.first * sizeof(unsigned int));
+	}
+	glBindVertexArray(0);
+
+	// the immediate mode primitives are drawn untransformed
+	glUniformMatrix4fv(m_modelLocation, 1, GL_FALSE, glm::value_ptr(glm::mat4(1.0f)));
+}
+
+void Renderer2D::destroyStatic(MeshHandle mesh) {
+	if (mesh == 0 || mesh > m_staticMeshes.size() || m_staticMeshes[mesh - 1].VAO == 0) {
+		return;
+	}
+	StaticMesh& staticMesh = m_staticMeshes[mesh - 1];
+	glDeleteVertexArrays(1, &staticMesh.VAO);
+	glDeleteBuffers(1, &staticMesh.VBO);
+	glDeleteBuffers(1, &staticMesh.EBO);
+	staticMesh.VAO = 0;
+	staticMesh.ranges.clear();
+}
+
+void Renderer2D::circlePoints(float* points, float x1, float y1, float radius) {
+	float rotDelta = glm::pi<float>() * 2 / CIRCLE_SEGMENTS;
+
+	for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+		points[i * 2 + 0] = glm::sin(rotDelta * i) * radius + x1;
+		points[i * 2 + 1] = glm::cos(rotDelta * i) * radius + y1;
+	}
+}
+
+ShapeHandle Renderer2D::createTriangle(float x1, float y1, float x2, float y2, float x3, float y3) {
+	float points[] = { x1, y1, x2, y2, x3, y3 };
+	float color[] = { m_r, m_g, m_b, m_a };
+	return m_shapePool->create(points, 3, color);
+}
+
+ShapeHandle Renderer2D::createRectangle(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4) {
+	float points[] = { x1, y1, x2, y2, x3, y3, x4, y4 };
+	float color[] = { m_r, m_g, m_b, m_a };
+	return m_shapePool->create(points, 4, color);
+}
+
+ShapeHandle Renderer2D::createCircle(float x1, float y1, float radius) {
+	float points[CIRCLE_SEGMENTS * 2];
+	circlePoints(points, x1, y1, radius);
+	float color[] = { m_r, m_g, m_b, m_a };
+	return m_shapePool->create(points, CIRCLE_SEGMENTS, color);
+}
+
+void Renderer2D::updateTriangle(ShapeHandle shape, float x1, float y1, float x2, float y2, float x3, float y3) {
+	float points[] = { x1, y1, x2, y2, x3, y3 };
+	m_shapePool->update(shape, points, 3);
+}
+
+void Renderer2D::updateRectangle(ShapeHandle shape, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4) {
+	float points[] = { x1, y1, x2, y2, x3, y3, x4, y4 };
+	m_shapePool->update(shape, points, 4);
+}
+
+void Renderer2D::updateCircle(ShapeHandle shape, float x1, float y1, float radius) {
+	float points[CIRCLE_SEGMENTS * 2];
+	circlePoints(points, x1, y1, radius);
+	m_shapePool->update(shape, points, CIRCLE_SEGMENTS);
+}
+
+void Renderer2D::setShapeColor(ShapeHandle shape, float r, float g, float b, float a) {
+	float color[] = { r, g, b, a };
+	m_shapePool->setColor(shape, color);
+}
+
+void Renderer2D::destroyShape(ShapeHandle shape) {
+	m_shapePool->destroy(shape);
+}
+
+void Renderer2D::drawShapes() {
+	// like drawStatic, all shapes share one depth, the pool draws them in creation order so newer shapes paint over older ones
+	if (m_blendMode != BLEND_OPAQUE) {
+		resolve();
+	}
+	nextDepth();
+	useProgram(m_shader);
+	applyBlendMode(m_blendMode);
+
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, m_depth));
+	model = glm::scale(model, glm::vec3(1.0f, 1.0f, 0.0f));
+	glUniformMatrix4fv(m_modelLocation, 1, GL_FALSE, glm::value_ptr(model));
+	m_shapePool->draw(m_camera.getVisibleBounds());
+	glUniformMatrix4fv(m_modelLocation, 1, GL_FALSE, glm::value_ptr(glm::mat4(1.0f)));
+}
+
+TextureHandle Renderer2D::loadTexture(const char* path) {
+	return m_textureLoader->load(path, m_imageDecoder);
+}
+
+unsigned int Renderer2D::getTexture(TextureHandle texture) const {
+	return m_textureLoader->getTexture(texture);
+}
+
+Renderer2D::TextureState Renderer2D::getTextureState(TextureHandle texture) const {
+	return m_textureLoader->getState(texture);
+}
+
+bool Renderer2D::getTextureSize(TextureHandle texture, int& width, int& height) const {
+	return m_textureLoader->getSize(texture, width, height);
+}
+
+size_t Renderer2D::getTextureMemory() const {
+	return m_textureLoader->getMemory();
+}
+
+void Renderer2D::destroyTexture(TextureHandle texture) {
+	m_textureLoader->destroy(texture);
+}
+
+void Renderer2D::setTextureUploadBudget(size_t bytes) {
+	m_textureLoader->setBudget(bytes);
+}
+
+void Renderer2D::setImageDecoder(const ImageDecoder& decoder) {
+	m_imageDecoder = decoder;
+}
+
+void Renderer2D::SetColor(float r, float g, float b, float a) {
+	m_r = r;
+	m_g = g;
+	m_b = b;
+	m_a = a;
+}
+
+void Renderer2D::setPostProcess(const PostProcessSettings& settings) {
+	m_postProcess->setSettings(settings);
+}
+
+const Renderer2D::PostProcessSettings& Renderer2D::getPostProcess() const {
+	return m_postProcess->getSettings();
+}
+
+void Renderer2D::setRenderTarget(RenderTarget* target) {
+	m_renderTarget = target;
+}
+
+void Renderer2D::resize(int framebufferWidth, int framebufferHeight, float contentScaleX, float contentScaleY) {
+	m_framebufferWidth = framebufferWidth;
+	m_framebufferHeight = framebufferHeight;
+	m_contentScaleX = (contentScaleX > 0.0f ? contentScaleX : 1.0f);
+	m_contentScaleY = (contentScaleY > 0.0f ? contentScaleY : 1.0f);
+	m_viewDirty = true;
+}
+
+void Renderer2D::setDefaultPass(const RenderPass& pass) {
+	m_defaultPass = pass;
+}
+
+void Renderer2D::setClearColor(float r, float g, float b, float a) {
+	m_defaultPass.clearColor[0] = r;
+	m_defaultPass.clearColor[1] = g;
+	m_defaultPass.clearColor[2] = b;
+	m_defaultPass.clearColor[3] = a;
+}
+
+void Renderer2D::loadPass(bool screen, bool depth) {
+	GLbitfield clear = 0;
+	GLenum attachments[3];
+	int count = 0;
+	if (m_pass.colorLoad == LOAD_CLEAR) {
+		clear |= GL_COLOR_BUFFER_BIT;
+		glClearColor(m_pass.clearColor[0], m_pass.clearColor[1], m_pass.clearColor[2], m_pass.clearColor[3]);
+	}
+	else if (m_pass.colorLoad == LOAD_DONT_CARE) {
+		attachments[count++] = (screen ? GL_COLOR : GL_COLOR_ATTACHMENT0);
+	}
+	if (depth && m_pass.depthLoad == LOAD_CLEAR) {
+		clear |= GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+		// the depth clear is masked like the depth writes
+		glDepthMask(GL_TRUE);
+	}
+	else if (depth && m_pass.depthLoad == LOAD_DONT_CARE) {
+		if (screen) {
+			attachments[count++] = GL_DEPTH;
+			attachments[count++] = GL_STENCIL;
+		}
+		else {
+			attachments[count++] = GL_DEPTH_STENCIL_ATTACHMENT;
+		}
+	}
+	// without invalidation a don't care load is a plain load, which is still correct
+	if (count > 0 && m_caps->invalidateFramebuffer) {
+		glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments);
+	}
+	if (clear != 0) {
+		glClear(clear);
+	}
+}
+
+void Renderer2D::storePass(bool screen, bool depth, bool color) {
+	GLenum attachments[3];
+	int count = 0;
+	if (color && m_pass.colorStore == STORE_DONT_CARE) {
+		attachments[count++] = (screen ? GL_COLOR : GL_COLOR_ATTACHMENT0);
+	}
+	if (depth && m_pass.depthStore == STORE_DONT_CARE) {
+		if (screen) {
+			attachments[count++] = GL_DEPTH;
+			attachments[count++] = GL_STENCIL;
+		}
+		else {
+			attachments[count++] = GL_DEPTH_STENCIL_ATTACHMENT;
+		}
+	}
+	if (count > 0 && m_caps->invalidateFramebuffer) {
+		glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments);
+	}
+}
+
+void Renderer2D::begin() {
+	begin(m_defaultPass);
+}
+
+void Renderer2D::begin(const RenderPass& pass) {
+	m_pass = pass;
+
+	// the camera works in window units, the viewport is set in pixels,
+	// the matrices are only uploaded again after a resize or a camera change
+	int width = (int)((float)m_framebufferWidth / m_contentScaleX + 0.5f);
+	int height = (int)((float)m_framebufferHeight / m_contentScaleY + 0.5f);
+	if (m_camera.update(width, height) || m_viewDirty) {
+		m_viewDirty = false;
+		int viewport[4];
+		m_camera.getViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+		m_viewport[0] = (int)(viewport[0] * m_contentScaleX);
+		m_viewport[1] = (int)(viewport[1] * m_contentScaleY);
+		m_viewport[2] = (int)(viewport[2] * m_contentScaleX);
+		m_viewport[3] = (int)(viewport[3] * m_contentScaleY);
+		glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]);
+
+		glm::mat4 model = glm::mat4(1.0f);
+
+		// pass the matrices into both shaders
+		unsigned int programs[] = { m_pointShader, m_textShader, m_shader };
+		for (unsigned int program : programs) {
+			useProgram(program);
+			glUniformMatrix4fv(glGetUniformLocation(program, "modelMatrix"), 1, GL_FALSE, glm::value_ptr(model));
+			glUniformMatrix4fv(glGetUniformLocation(program, "viewMatrix"), 1, GL_FALSE, m_camera.getViewMatrix());
+			glUniformMatrix4fv(glGetUniformLocation(program, "projectionMatrix"), 1, GL_FALSE, m_camera.getProjectionMatrix());
+			// size of a window unit in clip space, for the point quads
+			glUniform2f(glGetUniformLocation(program, "pixelSize"), 2.0f / (float)glm::max(viewport[2], 1), 2.0f / (float)glm::max(viewport[3], 1));
+		}
+	}
+	useProgram(m_shader);
+
+	// a target set with setRenderTarget is drawn into over all of it, otherwise with effects on
+	// the frame goes into a pooled target of the framebuffer size, the load actions are
+	// applied to whichever target the frame is drawn into
+	if (m_renderTarget != nullptr) {
+		glBindFramebuffer(GL_FRAMEBUFFER, m_renderTarget->framebuffer);
+		glViewport(0, 0, m_renderTarget->width, m_renderTarget->height);
+		loadPass(false, m_renderTarget->depth != 0);
+	}
+	else if (m_postProcess->isEnabled()) {
+		m_sceneTarget = m_targetPool->acquire(m_framebufferWidth, m_framebufferHeight, GL_RGBA8, true);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_sceneTarget->framebuffer);
+		loadPass(false, true);
+	}
+	else {
+		loadPass(true, true);
+	}
+
+	// layers are mapped to depth
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LEQUAL);
+	std::fill(m_layerPrimitives, m_layerPrimitives + MAX_LAYERS, 0);
+	m_sequence = 0;
+
+	m_appliedBlendMode = -1;
+	applyBlendMode(BLEND_ALPHA);
+
+	SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+	setLayer(0);
+	setBlendMode(BLEND_ALPHA);
+	setLineJoin(JOIN_MITER);
+	setLineCap(CAP_BUTT);
+}
+
+void Renderer2D::end() {
+	resolve();
+
+	// the effects write the screen and leave the viewport and program to be set again,
+	// the scene keeps its color for them whatever the store action
+	if (m_sceneTarget != nullptr) {
+		storePass(false, true, false);
+		m_postProcess->apply(m_sceneTarget, 0, m_caps->invalidateFramebuffer);
+		m_targetPool->release(m_sceneTarget);
+		m_sceneTarget = nullptr;
+		glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]);
+		m_appliedShader = 0;
+		m_appliedBlendMode = -1;
+	}
+	else if (m_renderTarget != nullptr) {
+		storePass(false, m_renderTarget->depth != 0, true);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]);
+	}
+	else {
+		storePass(true, true, true);
+	}
+
+	// leave the blend state as begin set it up and let the next clear reach the depth buffer
+	applyBlendMode(BLEND_ALPHA);
+	glDepthMask(GL_TRUE);
+	glDisable(GL_DEPTH_TEST);
+	m_appliedBlendMode = -1;
+}
+
+void Renderer2D::endFrame() {
+	// targets no pass took for a while go back to the driver
+	m_targetPool->trim(m_frame);
+
+	// the driver messages of the frame
+	m_debug->endFrame();
+
+	// upload what the texture loader decoded during the frame, within its budget, for the next one
+	m_textureLoader->update();
+
+	// drop the cached layouts of text that is no longer drawn
+	m_glyphCache->trim(m_frame);
+
+	// drop the cached triangulations of polygons that are no longer drawn
+	if (++m_frame % POLYGON_CACHE_FRAMES == 0) {
+		std::unordered_map<unsigned long long, CachedPolygon>::iterator it = m_polygonCache.begin();
+		while (it != m_polygonCache.end()) {
+			if (m_frame - it->second.lastFrame > POLYGON_CACHE_FRAMES) {
+				it = m_polygonCache.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+}
+
+Renderer2D::~Renderer2D() {
+	delete m_shapePool;
+	delete m_stroker;
+	for (size_t i = 0; i < m_staticMeshes.size(); ++i) {
+		destroyStatic((MeshHandle)(i + 1));
+	}
+	for (int i = 0; i < STREAM_REGIONS; ++i) {
+		if (m_streamFences[i] != nullptr) {
+			glDeleteSync((GLsync)m_streamFences[i]);
+		}
+	}
+	// deleting the buffers also unmaps them
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteBuffers(1, &m_EBO);
+	glDeleteVertexArrays(1, &m_pointVAO);
+	glDeleteBuffers(1, &m_pointVBO);
+	glDeleteProgram(m_shader);
+	glDeleteProgram(m_pointShader);
+	glDeleteVertexArrays(1, &m_textVAO);
+	glDeleteBuffers(1, &m_textVBO);
+	glDeleteProgram(m_textShader);
+	delete m_glyphCache;
+	delete m_textureLoader;
+	delete m_postProcess;
+	delete m_targetPool;
+	delete m_debug;
+	delete m_caps;
 }
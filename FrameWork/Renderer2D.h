@@ -17,8 +17,210 @@
 #ifndef RENDERER2D_H_
 #define RENDERER2D_H_
 
+#include "Camera2D.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// handle of a retained shape, 0 is never a valid handle
+typedef unsigned int ShapeHandle;
+
+// handle of a baked static mesh, 0 is never a valid handle
+typedef unsigned int MeshHandle;
+
+// handle of a triangulated polygon, 0 is never a valid handle
+typedef unsigned int PolygonHandle;
+
+// handle of a font, 0 is never a valid handle
+typedef unsigned int FontHandle;
+
+// handle of a texture, 0 is never a valid handle
+typedef unsigned int TextureHandle;
+
+class GLDebug;
+class GlyphCache;
+class PostProcess;
+class RenderTargetPool;
+class ShapePool;
+class TextureLoader;
+struct GLCaps;
+struct RenderTarget;
+namespace Stroke { class Stroker; }
 class Renderer2D {
 public:
+	struct Vertex {
+		float pos[3];
+		float color[4];
+	};
+
+	// axis aligned rectangle for drawRects
+	struct Rect {
+		// bottom left corner
+		float x, y;
+		float width, height;
+		float color[4];
+	};
+
+	// triangle for drawTriangles
+	struct Triangle {
+		float points[6];
+		float color[4];
+	};
+
+	// circle for drawCircles
+	struct Circle {
+		float x, y;
+		float radius;
+		float color[4];
+	};
+
+	// line segment for drawLines
+	struct Line {
+		float x1, y1;
+		float x2, y2;
+		float width;
+		float color[4];
+	};
+
+	// point for drawPoints
+	struct Point {
+		float x, y;
+		// width and height in pixels
+		float size;
+		float color[4];
+	};
+
+	// how a primitive is combined with what is already on the screen
+	enum BlendMode {
+		// depth tested and written, drawn front to back
+		BLEND_OPAQUE,
+		// depth tested, drawn back to front in submission order within its layer
+		BLEND_ALPHA,
+		// depth tested, drawn after the alpha blended primitives of its layer
+		BLEND_ADDITIVE
+	};
+
+	// shape of the corners where the segments of a polyline meet
+	enum LineJoin {
+		JOIN_MITER,
+		JOIN_BEVEL,
+		JOIN_ROUND
+	};
+
+	// shape of the open ends of a line
+	enum LineCap {
+		CAP_BUTT,
+		CAP_SQUARE,
+		CAP_ROUND
+	};
+
+	// pixels of one glyph, filled by FontSource::rasterize
+	struct Glyph {
+		// coverage from 0 to 255, width * height bytes, the first row is the top one
+		const unsigned char* pixels;
+		int width, height;
+		// top left pixel relative to the pen position on the baseline, in pixels, y up
+		int left, top;
+	};
+
+	// font the glyphs are rasterized from, for TrueType fonts the callbacks wrap
+	// stb_truetype or FreeType, user has to outlive the font
+	struct FontSource {
+		void* user;
+		// line metrics in em, ascent and descent both positive
+		float ascent, descent, lineGap;
+		// draws codepoint at pixelsPerEm into glyph, the pixels only have to stay valid until the next call
+		// @return false if the font has no glyph for codepoint
+		bool (*rasterize)(void* user, unsigned int codepoint, int pixelsPerEm, Glyph& glyph);
+		// pen advance from codepoint to next in em, with kerning, next is 0 at the end of a line
+		float (*advance)(void* user, unsigned int codepoint, unsigned int next);
+	};
+
+	// effects run on the frame at end, all off by default, see setPostProcess
+	struct PostProcessSettings {
+		// bright parts glow into their surroundings, 0 turns bloom off
+		float bloomIntensity;
+		// brightness, 0 to 1, above which a pixel glows
+		float bloomThreshold;
+		// half sized levels the glow spreads over, 1 to 6, each level doubles its reach
+		int bloomLevels;
+		// gaussian blur of the whole frame, standard deviation in pixels, 0 turns it off
+		float blur;
+		// color grading, the color is scaled by exposure and tint, then contrast is applied
+		// around mid gray and then saturation, all at 1 leave the color as it is
+		float exposure;
+		float contrast;
+		float saturation;
+		float tint[3];
+	};
+
+	// what a frame starts with in its target, see RenderPass
+	enum LoadAction {
+		// what the target holds already
+		LOAD_KEEP,
+		// RenderPass::clearColor and the far depth
+		LOAD_CLEAR,
+		// undefined, the frame has to cover every pixel, saves reading the target back in
+		LOAD_DONT_CARE
+	};
+
+	// what a frame leaves behind in its target
+	enum StoreAction {
+		STORE_KEEP,
+		// the contents are dropped at end, saves writing them out
+		STORE_DONT_CARE
+	};
+
+	// load and store actions of a frame, depth covers the stencil as well,
+	// the clears are done with one glClear and the don't care actions with one
+	// glInvalidateFramebuffer each, so a target is touched at most once per frame
+	struct RenderPass {
+		LoadAction colorLoad;
+		LoadAction depthLoad;
+		StoreAction colorStore;
+		StoreAction depthStore;
+		float clearColor[4];
+	};
+
+	// decodes image files for loadTexture, called on the loader threads, so it has to be thread safe,
+	// wraps stb_image or similar, user has to outlive the loads
+	struct ImageDecoder {
+		void* user;
+		// writes RGBA8 rows into pixels, the bottom row first as GL expects them
+		// @return false if data is not an image the decoder reads
+		bool (*decode)(void* user, const unsigned char* data, size_t size,
+			int& width, int& height, std::vector<unsigned char>& pixels);
+	};
+
+	// where a loaded texture is
+	enum TextureState {
+		// being read, decoded or uploaded, the placeholder is sampled meanwhile
+		TEXTURE_LOADING,
+		TEXTURE_RESIDENT,
+		// the file could not be read or decoded, the placeholder stays
+		TEXTURE_FAILED
+	};
+
+	// importance of a driver message, see enableDebugOutput
+	enum DebugSeverity {
+		DEBUG_SEVERITY_NOTIFICATION,
+		DEBUG_SEVERITY_LOW,
+		DEBUG_SEVERITY_MEDIUM,
+		DEBUG_SEVERITY_HIGH
+	};
+
+	// kinds of driver messages, combined as bits
+	enum DebugType {
+		DEBUG_TYPE_ERROR = 1 << 0,
+		DEBUG_TYPE_DEPRECATED = 1 << 1,
+		DEBUG_TYPE_UNDEFINED = 1 << 2,
+		DEBUG_TYPE_PORTABILITY = 1 << 3,
+		// implicit syncs, shader recompiles, slow paths
+		DEBUG_TYPE_PERFORMANCE = 1 << 4,
+		DEBUG_TYPE_OTHER = 1 << 5,
+		DEBUG_TYPE_ALL = (1 << 6) - 1
+	};
+
 	Renderer2D();
 
 	// draws a triangle on the screen
@@ -27,7 +229,8 @@ public:
 	// @param x3, y3 center point
 	void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3);
 
-	// draws a point on the screen
+	// draws a square point on the screen
+	// @param size width and height in pixels
 	void drawPoint(float x1, float y1, float size = 1.0f);
 
 	// draws a rectangle
@@ -40,43 +243,571 @@ public:
 	// draws a circle
 	void drawCircle(float x1, float y1, float radius);
 
-	// draws a line
+	// draws a line as triangles, lines of any width batch together
 	void drawLine(float x1, float y1, float x2, float y2, float width = 1.0f);
 
+	// draws an array of rectangles, each with its own color
+	// the rectangles of one call share a depth and are drawn in array order
+	void drawRects(const Rect* rects, int count);
+
+	// structure of arrays variant of drawRects
+	// @param colors rgba per rectangle, or nullptr to use the current color
+	void drawRects(const float* x, const float* y, const float* width, const float* height, const float* colors, int count);
+
+	// draws an array of circles, each with its own color
+	void drawCircles(const Circle* circles, int count);
+
+	// structure of arrays variant of drawCircles
+	// @param colors rgba per circle, or nullptr to use the current color
+	void drawCircles(const float* x, const float* y, const float* radius, const float* colors, int count);
+
+	// draws an array of lines, each with its own width and color
+	void drawLines(const Line* lines, int count);
+
+	// draws connected line segments as one primitive with the current join and cap,
+	// widths of 1 pixel or less on screen, width times the camera zoom and the content scale, skip the joins and caps
+	// @param points x, y pairs
+	// @param closed connects the last point back to the first
+	void drawPolyline(const float* points, int count, float width = 1.0f, bool closed = false);
+
+	// streams a polyline too long to keep in memory, the points are added in any
+	// number of calls and continue across flushes without a seam
+	// no other draw calls may be made until endPolyline
+	void beginPolyline(float width = 1.0f, bool closed = false);
+	void addPolylinePoints(const float* points, int count);
+	void endPolyline();
+
+	// draws an array of points, each with its own size and color,
+	// the points of consecutive calls are drawn with one instanced call
+	void drawPoints(const Point* points, int count);
+
+	// draws an array of triangles, each with its own color
+	// the triangles of one call share a depth and are drawn in array order
+	void drawTriangles(const Triangle* triangles, int count);
+
+	// draws a filled polygon, which may be concave and have holes
+	// the triangulation is cached by the points, so unchanged polygons are not clipped again
+	// @param points x, y pairs of all rings one after another
+	// @param count total number of points
+	// @param ringSizes points per ring, the first ring is the outline and the others are holes,
+	//        nullptr for a single outline, the sizes must add up to count
+	void drawPolygon(const float* points, int count, const int* ringSizes = nullptr, int ringCount = 0);
+
+	// triangulates a polygon once, for polygons that only move
+	// @return handle of the polygon, 0 if the ring sizes do not add up to count
+	PolygonHandle createPolygon(const float* points, int count, const int* ringSizes = nullptr, int ringCount = 0);
+
+	// draws a created polygon with the current color, transformed on the CPU
+	// so it batches with the other primitives
+	// @param rotation rotation in radians around the polygon origin
+	void drawPolygon(PolygonHandle polygon, float x, float y, float rotation = 0.0f, float scale = 1.0f);
+
+	// releases a created polygon
+	void destroyPolygon(PolygonHandle polygon);
+
+	// retained shapes live on the GPU until they are destroyed,
+	// they are created with the current color and drawn with drawShapes,
+	// where overlapping shapes are painted in creation order, newer over older
+	ShapeHandle createTriangle(float x1, float y1, float x2, float y2, float x3, float y3);
+	ShapeHandle createRectangle(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4);
+	ShapeHandle createCircle(float x1, float y1, float radius);
+
+	// moves a retained shape, only the changed shape is uploaded again
+	void updateTriangle(ShapeHandle shape, float x1, float y1, float x2, float y2, float x3, float y3);
+	void updateRectangle(ShapeHandle shape, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4);
+	void updateCircle(ShapeHandle shape, float x1, float y1, float radius);
+
+	// recolors a retained shape
+	void setShapeColor(ShapeHandle shape, float r, float g, float b, float a);
+
+	// removes a retained shape
+	void destroyShape(ShapeHandle shape);
+
+	// draws the retained shapes the camera sees with a single draw call,
+	// they are found through a grid, so shapes far off screen cost nothing
+	// opaque shapes take a depth in the current layer like one primitive, translucent ones
+	// first draw everything queued and are then blended in call order, so translucent
+	// primitives submitted after them are drawn over them whatever their layer
+	void drawShapes();
+
+	// records the following draw calls into a static mesh instead of drawing them
+	void beginStatic();
+
+	// uploads the recorded geometry into an immutable mesh
+	// @return handle of the mesh, 0 if nothing was recorded
+	MeshHandle endStatic();
+
+	// draws a baked mesh with one draw call per primitive type,
+	// in the current layer and blend mode with the same ordering as drawShapes
+	// @param x, y translation
+	// @param rotation rotation in radians around the mesh origin
+	// @param scale uniform scale
+	void drawStatic(MeshHandle mesh, float x = 0.0f, float y = 0.0f, float rotation = 0.0f, float scale = 1.0f);
+
+	// releases the GPU buffers of a baked mesh
+	void destroyStatic(MeshHandle mesh);
+
+	// adds a font, its glyphs are rasterized once as signed distance fields,
+	// so one atlas entry serves every size
+	// @return handle of the font
+	FontHandle createFont(const FontSource& source);
+
+	// releases a created font and its glyphs
+	void destroyFont(FontHandle font);
+
+	// 8x8 pixel font for ASCII that is always there, other characters show as '?'
+	FontHandle getBuiltinFont() const;
+
+	// font of the following text
+	void setFont(FontHandle font);
+
+	// draws UTF-8 text with the current font, color, layer and blend mode, '\n' starts a new line,
+	// text is always blended, in BLEND_OPAQUE it is alpha blended
+	// glyphs of all text calls are instanced quads from one atlas, so labels batch into a single draw call,
+	// the layout of each string is cached, text is not recorded into static meshes
+	// @param x, y - pen position on the baseline of the first line
+	// @param size - em height in world units, 8 draws the built-in font pixel for pixel at zoom 1
+	void drawText(float x, float y, const char* text, float size = 16.0f);
+
+	// size of text as drawText would lay it out, from the left of the first glyph to the widest line end
+	// and from the top of the first line to the bottom of the last
+	void measureText(const char* text, float size, float& width, float& height);
+
+	// loads an image without stalling the frame, the file is read and decoded on worker threads
+	// and uploaded over the next frames within the upload budget, through a ring of pixel
+	// unpack buffers, and mipmapped once all of it is there
+	// KTX and KTX2 files with BC1, BC3, BC7 or ETC2 blocks stay compressed with the mip chain they hold,
+	// formats the context cannot sample are decoded to RGBA8 first, BC7 fails then,
+	// rows are flipped to put the bottom row first like the decoded images, as KTXorientation says,
+	// except BC7 and ETC2 blocks the context samples and BC1 or BC3 chains with a level that is not
+	// a whole number of blocks high, those cannot be flipped and keep the order of the file
+	// @return handle of the texture
+	TextureHandle loadTexture(const char* path);
+
+	// GL texture of a handle, a checkerboard placeholder until the texture is resident
+	unsigned int getTexture(TextureHandle texture) const;
+	TextureState getTextureState(TextureHandle texture) const;
+
+	// size of a texture once it is decoded
+	// @return false while it is decoded or if it failed
+	bool getTextureSize(TextureHandle texture, int& width, int& height) const;
+
+	// bytes of GPU memory the resident textures take, mipmaps included
+	size_t getTextureMemory() const;
+
+	// deletes a texture, also one that is still loading
+	void destroyTexture(TextureHandle texture);
+
+	// bytes uploaded per frame, 4 MB by default, lower budgets spread the uploads over more frames
+	void setTextureUploadBudget(size_t bytes);
+
+	// decoder of the following loads other than KTX, the built-in one reads TGA and binary PPM
+	void setImageDecoder(const ImageDecoder& decoder);
+
 	// change the color of the render screen
 	void SetColor(float r, float g, float b, float a);
 
-	// use the shader program
+	// layer of the following primitives, higher layers are drawn on top
+	// and within a layer later primitives are drawn on top, layers map to depth
+	// translucent primitives are held back until end when the queue fills up, so the order
+	// holds across the whole frame, except around translucent drawShapes and drawStatic calls,
+	// text that fills the glyph atlas and destroyFont, which draw everything queued so far
+	// @param layer 0 to MAX_LAYERS - 1
+	void setLayer(int layer);
+
+	// blend mode of the following primitives
+	void setBlendMode(BlendMode blendMode);
+
+	// join and cap of the following lines
+	void setLineJoin(LineJoin join);
+	void setLineCap(LineCap cap);
+
+	// tells the renderer the new framebuffer size, begin reads the cached size
+	// @param framebufferWidth, framebufferHeight - size in pixels
+	// @param contentScaleX, contentScaleY - pixels per window unit, the camera works in
+	//        window units so the world keeps its size on high DPI displays
+	void resize(int framebufferWidth, int framebufferHeight, float contentScaleX = 1.0f, float contentScaleY = 1.0f);
+
+	// camera the next frame is seen through, changes take effect at the next begin
+	Camera2D& getCamera() { return m_camera; }
+
+	// true if a world space box overlaps what the camera saw at the last begin,
+	// the draw calls skip primitives outside it before writing any vertices
+	bool isVisible(float minX, float minY, float maxX, float maxY) const;
+
+	// prints the driver messages of the given types and severities, each distinct message
+	// once per frame with the number of times it came, later repeats are only counted,
+	// the renderer's buffers and programs are labeled so the messages name them
+	// needs GL 4.3 or KHR_debug, some drivers only send messages to a debug context (OPENGLFW_GL_DEBUG)
+	// @param types - DebugType bits
+	// @return false if the context has no debug output
+	bool enableDebugOutput(int types = DEBUG_TYPE_PERFORMANCE | DEBUG_TYPE_ERROR | DEBUG_TYPE_UNDEFINED,
+		DebugSeverity minimum = DEBUG_SEVERITY_LOW);
+	void disableDebugOutput();
+
+	// effects of the following frames, while any is on the frame is drawn into an off-screen
+	// target and written to the screen by the effects, which work on pooled targets of
+	// half size and less and blur in two passes of linearly filtered taps
+	void setPostProcess(const PostProcessSettings& settings);
+	const PostProcessSettings& getPostProcess() const;
+
+	// framebuffer the following frames are drawn into, nullptr for the screen,
+	// the view of the camera covers the whole target and the effects are skipped,
+	// the load and store actions of begin apply to the target, see RenderGraph
+	void setRenderTarget(RenderTarget* target);
+	RenderTarget* getRenderTarget() const { return m_renderTarget; }
+
+	// pool of the off-screen targets, shared with the effects and render graphs
+	RenderTargetPool* getTargetPool() const { return m_targetPool; }
+
+	// version and code paths of the context
+	const GLCaps* getCaps() const { return m_caps; }
+
+	// compiles and links a shader program, errors are written to the console
+	// @param version - #version line put in front of both sources
+	// @param vertexShaderSource, fragmentShaderSource - GLSL sources without a #version line
+	static unsigned int createProgram(const char* version, const char* vertexShaderSource, const char* fragmentShaderSource);
+
+	// actions of the frames started with begin(), by default color and depth are cleared,
+	// color is kept and depth is dropped at end, so a second frame drawn over the first
+	// has to load color with LOAD_KEEP
+	void setDefaultPass(const RenderPass& pass);
+	const RenderPass& getDefaultPass() const { return m_defaultPass; }
+
+	// color the default pass clears to
+	void setClearColor(float r, float g, float b, float a);
+
+	// starts a frame in the current target with the default pass
 	void begin();
 
-	// delete the shader program
+	// starts a frame in the current target, with effects on in the off-screen target of the frame,
+	// the load actions are applied here and the store actions at end
+	void begin(const RenderPass& pass);
+
+	// sorts and draws the queued primitives
 	void end();
 
+	// finishes the frame once after its last end(), however many passes it drew: advances the
+	// frame counter, reports the driver messages, uploads decoded textures and trims the caches,
+	// runApp calls it before swapping the buffers
+	void endFrame();
+
 	~Renderer2D();
 
 protected:
-	enum { MAX_SPRITES = 512 };
+	enum {
+		MAX_SPRITES = 16384,
+		MAX_VERTICES = MAX_SPRITES * 4,
+		MAX_INDICES = MAX_SPRITES * 6,
+		MAX_LAYERS = 256,
+		// distinct depths per layer and frame, within the 24-bit depth buffer resolution
+		LAYER_STEPS = 32768,
+		CIRCLE_SEGMENTS = 32,
+		// cached triangulations not drawn for this many frames are dropped
+		POLYGON_CACHE_FRAMES = 120,
+		// flushes the persistent mapped streaming buffers hold before one is reused
+		STREAM_REGIONS = 3
+	};
 
-	unsigned int m_shader;
+	// primitive type part of the sort key
+	enum {
+		PIPELINE_TRIANGLES,
+		PIPELINE_POINTS,
+		PIPELINE_TEXT
+	};
 
-	float m_cameraScale;
+	// writes the outline of a circle as x, y pairs
+	static void circlePoints(float* points, float x1, float y1, float radius);
 
-	unsigned int m_VBO, m_VAO, m_EBO;
+	// bounds the draw calls are culled against, nullptr while recording a static mesh,
+	// which may be drawn anywhere
+	const float* cullBounds() const;
 
-	struct Vertex {
+	// true if the bounding box of x, y pairs, grown by margin, is visible
+	bool pointsVisible(const float* points, int count, float margin) const;
+
+	// framebuffer pixels per world unit, the camera zoom times the larger content scale,
+	// for the thin stroke threshold
+	float pixelsPerUnit() const;
+
+	// appends a vertex with the current color
+	void addVertex(float x, float y);
+
+	// appends a vertex with the given color
+	void addVertex(float x, float y, const float* color);
+
+	// tessellates a polyline with the current join and cap and queues it as one primitive
+	void stroke(const float* points, int count, bool closed, float width, const float* color);
+
+	// queues a triangulated polygon, transformed by rotation, scale and then translation
+	void fillPolygon(const float* points, int count, const std::vector<unsigned int>& indices,
+		float x, float y, float rotation, float scale);
+
+	// starts a primitive the polyline stroker writes into
+	void beginStroke();
+
+	// queues what the polyline stroker wrote since beginStroke
+	void submitStroke();
+
+	// flushes the queue when a primitive of this size would not fit
+	// and assigns the depth of the primitive
+	void beginPrimitive(int vertexCount, int indexCount);
+
+	// flushes the queue when a primitive of this size would not fit, without assigning a depth,
+	// for the batch draws that only take a depth once culling left something to draw
+	void reservePrimitive(int vertexCount, int indexCount);
+
+	// assigns the next depth of the current layer to m_depthKey and m_depth
+	void nextDepth();
+
+	// the depth key and depth nextDepth assigns next, without taking them
+	unsigned int pendingDepthKey() const;
+	float pendingDepth() const;
+
+	// builds the sort key of a primitive from the current layer, depth and blend mode, see SortKey::make
+	unsigned long long makeKey(unsigned int pipeline, unsigned int texture) const;
+
+	// queues the vertices and indices written since firstVertex and firstIndex,
+	// or moves them into the static mesh while baking
+	// @param mode GL_TRIANGLES
+	void submit(unsigned int mode, int firstVertex, int firstIndex);
+
+	// queues a primitive with the current sort key
+	// @param first, count range of m_indices, or of m_points for PIPELINE_POINTS
+	// @param firstVertex, vertexCount range of m_vertices the indices point into, 0 for instances
+	void queueCommand(unsigned int pipeline, int first, int count, int firstVertex, int vertexCount);
+
+	// binds a shader program if it is not bound already
+	void useProgram(unsigned int program);
+
+	// makes room in the queue in the middle of a frame, the opaque primitives are drawn
+	// and the translucent ones are held back until resolve, so the translucent primitives
+	// queued later still sort with them by layer
+	void flush();
+
+	// draws the queued and the held back primitives in key order
+	void resolve();
+
+	// moves the queued translucent primitives and their data out of the queue
+	void deferTranslucent();
+
+	// sorts the queued primitives by key and draws them in as few batches as possible
+	void drawQueued();
+
+	// waits until the GPU no longer reads the streaming region about to be written
+	void waitStreamRegion();
+
+	// points the attributes of the text VAO at the glyph instances starting at firstInstance
+	void setGlyphAttributes(int firstInstance);
+
+	// applies the load or the store actions of m_pass to the bound framebuffer
+	// @param screen - the default framebuffer, which names its attachments differently
+	// @param depth - the framebuffer has a depth stencil buffer
+	// @param color - color is affected, false for the scene target that the effects still read
+	void loadPass(bool screen, bool depth);
+	void storePass(bool screen, bool depth, bool color);
+
+	// changes the GL blend state if it differs from the applied one
+	void applyBlendMode(int blendMode);
+
+	// queued primitive
+	struct Command {
+		unsigned long long key;
+		// range of indices, or of point instances
+		int first;
+		int count;
+		// range of vertices the indices point into
+		int firstVertex;
+		int vertexCount;
+		unsigned int pipeline;
+		unsigned int blendMode;
+	};
+
+	// run of sorted indices or point instances drawn with one call
+	struct Batch {
+		unsigned int pipeline;
+		unsigned int blendMode;
+		int first;
+		int count;
+	};
+
+	// per instance data of a point quad
+	struct PointInstance {
+		float pos[3];
+		float size;
+		float color[4];
+	};
+
+	// per instance data of a glyph quad
+	struct GlyphInstance {
+		// bottom left corner and depth
 		float pos[3];
+		float size[2];
+		// atlas coordinates of the bottom left and top right corner
+		float uv[4];
 		float color[4];
 	};
 
-	Vertex m_vertices[MAX_SPRITES * 4];
+	// run of indices that share a primitive type inside a static mesh
+	struct MeshRange {
+		unsigned int mode;
+		unsigned int first;
+		unsigned int count;
+	};
+
+	struct StaticMesh {
+		unsigned int VAO, VBO, EBO;
+		std::vector<MeshRange> ranges;
+		// furthest vertex from the mesh origin, for culling
+		float radius;
+	};
+
+	struct CachedPolygon {
+		// the polygon triangulated, compared on a hit so a hash collision is not drawn with the wrong triangles
+		std::vector<float> points;
+		std::vector<int> ringSizes;
+		std::vector<unsigned int> indices;
+		unsigned int lastFrame;
+	};
+
+	// polygon created with createPolygon, empty once destroyed
+	struct Polygon {
+		std::vector<float> points;
+		std::vector<unsigned int> indices;
+		// furthest point from the polygon origin, for culling
+		float radius;
+	};
+
+	// version and code paths of the context
+	GLCaps* m_caps;
+
+	// driver messages, off unless enableDebugOutput is called
+	GLDebug* m_debug;
+
+	unsigned int m_shader;
+	unsigned int m_pointShader;
+	unsigned int m_textShader;
+	unsigned int m_appliedShader;
+
+	int m_modelLocation;
+
+	Camera2D m_camera;
+
+	// framebuffer size in pixels and pixels per window unit, set by resize
+	int m_framebufferWidth, m_framebufferHeight;
+	// viewport of the camera in pixels, set again after the effects drew the screen
+	int m_viewport[4];
+	float m_contentScaleX, m_contentScaleY;
+	// the viewport and matrices have to be set again
+	bool m_viewDirty;
+
+	unsigned int m_VBO, m_VAO, m_EBO;
+
+	Vertex m_vertices[MAX_VERTICES];
+
+	unsigned int m_indices[MAX_INDICES];
+
+	// indices of the queued primitives in draw order
+	unsigned int m_sortedIndices[MAX_INDICES];
+
+	// persistent mapped streaming buffers, nullptr when the buffers are orphaned instead,
+	// each flush writes the next of STREAM_REGIONS regions, guarded by a GLsync fence
+	Vertex* m_mappedVertices;
+	unsigned int* m_mappedIndices;
+	void* m_streamFences[STREAM_REGIONS];
+	int m_streamRegion;
+
+	// queued points, and the same in draw order, drawn from their own instance buffer
+	std::vector<PointInstance> m_points;
+	std::vector<PointInstance> m_sortedPoints;
+	unsigned int m_pointVAO, m_pointVBO;
+
+	// queued glyphs, and the same in draw order, drawn from their own instance buffer
+	std::vector<GlyphInstance> m_glyphs;
+	std::vector<GlyphInstance> m_sortedGlyphs;
+	unsigned int m_textVAO, m_textVBO;
+
+	// textures loaded in the background and the decoder of the following loads
+	TextureLoader* m_textureLoader;
+	ImageDecoder m_imageDecoder;
+
+	// glyph atlas, fonts and cached layouts, and the font of the following text
+	GlyphCache* m_glyphCache;
+	FontHandle m_font;
+
+	std::vector<Command> m_commands;
+	std::vector<Batch> m_batches;
+
+	// translucent primitives held back by flush and their data, drawn by resolve
+	std::vector<Command> m_deferredCommands;
+	std::vector<Command> m_sortedDeferred;
+	std::vector<Vertex> m_deferredVertices;
+	std::vector<unsigned int> m_deferredIndices;
+	std::vector<PointInstance> m_deferredPoints;
+	std::vector<GlyphInstance> m_deferredGlyphs;
+
+	// primitives queued this frame, the submission order part of the sort key
+	unsigned int m_sequence;
 
-	unsigned int m_indices[MAX_SPRITES * 6];
+	// radix sort buffers, kept to avoid allocating every frame
+	std::vector<unsigned long long> m_sortKeys;
+	std::vector<unsigned long long> m_sortTmpKeys;
+	std::vector<unsigned int> m_sortValues;
+	std::vector<unsigned int> m_sortTmpValues;
+
+	int m_layer;
+	BlendMode m_blendMode;
+	LineJoin m_lineJoin;
+	LineCap m_lineCap;
+
+	// primitives drawn in each layer this frame
+	int m_layerPrimitives[MAX_LAYERS];
+
+	// depth of the primitive being written, as sort key and as vertex z
+	unsigned int m_depthKey;
+	float m_depth;
+	int m_appliedBlendMode;
 
 	float m_r, m_g, m_b, m_a;
 
 	int m_currentVertex;
 
 	int m_currentIndex;
+
+	ShapePool* m_shapePool;
+
+	// polyline being streamed, its color and where its primitive starts
+	Stroke::Stroker* m_stroker;
+	float m_strokeColor[4];
+	int m_strokeFirstVertex;
+	int m_strokeFirstIndex;
+
+	// static mesh recording
+	bool m_recording;
+	std::vector<Vertex> m_staticVertices;
+	std::vector<unsigned int> m_staticIndices;
+	std::vector<MeshRange> m_staticRanges;
+
+	std::vector<StaticMesh> m_staticMeshes;
+
+	// triangulations of drawPolygon keyed by the hash of the polygon
+	std::unordered_map<unsigned long long, CachedPolygon> m_polygonCache;
+	std::vector<Polygon> m_polygons;
+
+	// off-screen targets and the effects drawn with them, the frame is drawn
+	// into m_sceneTarget between begin and end while an effect is on
+	RenderTargetPool* m_targetPool;
+	PostProcess* m_postProcess;
+	RenderTarget* m_sceneTarget;
+	// set by setRenderTarget, nullptr while drawing to the screen
+	RenderTarget* m_renderTarget;
+
+	// actions of begin() and of the frame being drawn
+	RenderPass m_defaultPass;
+	RenderPass m_pass;
+
+	// frames begun so far
+	unsigned int m_frame;
 };
 
 #endif // !RENDERER2D_H_
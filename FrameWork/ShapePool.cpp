@@ -0,0 +1,339 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: ShapePool.cpp
+*
+* Description:	GPU resident pool of retained shapes.
+*				Shapes are addressed by handles, only the vertex and index ranges of
+*				changed shapes are uploaded and the visible shapes are drawn with one call.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "ShapePool.h"
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+
+// a handle stores the slot index + 1 in the low 20 bits and the slot generation in the high 12 bits,
+// so handles of destroyed shapes are rejected once their slot is reused, a slot whose generation
+// would wrap is retired instead of reused so an old handle can never match it again
+static const unsigned int HANDLE_INDEX_BITS = 20;
+static const unsigned int HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1;
+static const unsigned int HANDLE_GENERATION_MASK = (1u << (32 - HANDLE_INDEX_BITS)) - 1;
+
+ShapePool::ShapePool(bool directStateAccess) : m_directStateAccess(directStateAccess),
+	m_vertexCapacity(0), m_indexCapacity(0), m_grid((float)CELL_SIZE), m_liveShapes(0),
+	m_drawOrderDirty(false), m_slotsInOrder(true), m_nextSequence(0) {
+	glGenVertexArrays(1, &m_VAO);
+	glGenBuffers(1, &m_VBO);
+	glGenBuffers(1, &m_EBO);
+
+	glBindVertexArray(m_VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+	// same layout as the immediate mode vertices
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Renderer2D::Vertex), (char*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Renderer2D::Vertex), (char*)12);
+	glEnableVertexAttribArray(1);
+
+	glBindVertexArray(0);
+	GLDebug::label(GL_VERTEX_ARRAY, m_VAO, "ShapePool VAO");
+	GLDebug::label(GL_BUFFER, m_VBO, "ShapePool vertices");
+	GLDebug::label(GL_BUFFER, m_EBO, "ShapePool indices");
+}
+
+ShapeHandle ShapePool::create(const float* points, int count, const float* color) {
+	int slot = -1;
+
+	// reuse the vertex and index range of a dead shape of the same size
+	std::map<int, std::vector<int>>::iterator it = m_freeSlots.find(count);
+	if (it != m_freeSlots.end() && !it->second.empty()) {
+		slot = it->second.back();
+		it->second.pop_back();
+	}
+	else {
+		// slot + 1 has to fit in the index bits of the handle
+		if (m_shapes.size() >= HANDLE_INDEX_MASK) {
+			std::cout << "ERROR::SHAPEPOOL::TOO_MANY_SHAPES" << std::endl;
+			return 0;
+		}
+		Shape shape;
+		shape.firstVertex = (int)m_vertices.size();
+		shape.vertexCount = count;
+		shape.firstIndex = (int)m_indices.size();
+		shape.indexCount = (count - 2) * 3;
+		shape.generation = 0;
+		shape.alive = false;
+
+		m_vertices.resize(m_vertices.size() + shape.vertexCount);
+		m_indices.resize(m_indices.size() + shape.indexCount);
+
+		slot = (int)m_shapes.size();
+		m_shapes.push_back(shape);
+	}
+
+	Shape& shape = m_shapes[slot];
+	shape.alive = true;
+	shape.sequence = m_nextSequence++;
+	m_liveShapes++;
+	m_drawOrderDirty = true;
+
+	for (int i = 0; i < shape.vertexCount; ++i) {
+		Renderer2D::Vertex& v = m_vertices[shape.firstVertex + i];
+		v.color[0] = color[0];
+		v.color[1] = color[1];
+		v.color[2] = color[2];
+		v.color[3] = color[3];
+	}
+	writeShape(shape, points);
+
+	return (shape.generation << HANDLE_INDEX_BITS) | (unsigned int)(slot + 1);
+}
+
+void ShapePool::update(ShapeHandle handle, const float* points, int count) {
+	Shape* shape = lookup(handle);
+	// shapes keep the point count they were created with
+	if (shape == nullptr || shape->vertexCount != count) {
+		return;
+	}
+	writeShape(*shape, points);
+}
+
+void ShapePool::setColor(ShapeHandle handle, const float* color) {
+	Shape* shape = lookup(handle);
+	if (shape == nullptr) {
+		return;
+	}
+	for (int i = 0; i < shape->vertexCount; ++i) {
+		Renderer2D::Vertex& v = m_vertices[shape->firstVertex + i];
+		v.color[0] = color[0];
+		v.color[1] = color[1];
+		v.color[2] = color[2];
+		v.color[3] = color[3];
+	}
+	Range range = { shape->firstVertex, shape->firstVertex + shape->vertexCount };
+	m_dirtyVertices.push_back(range);
+}
+
+void ShapePool::destroy(ShapeHandle handle) {
+	Shape* shape = lookup(handle);
+	if (shape == nullptr) {
+		return;
+	}
+	shape->alive = false;
+	shape->generation++;
+	m_liveShapes--;
+	m_drawOrderDirty = true;
+	m_grid.remove((unsigned int)(shape - &m_shapes[0]));
+
+	// collapse the triangles so the dead range draws nothing
+	std::fill(m_indices.begin() + shape->firstIndex,
+		m_indices.begin() + shape->firstIndex + shape->indexCount, (unsigned int)shape->firstVertex);
+	Range range = { shape->firstIndex, shape->firstIndex + shape->indexCount };
+	m_dirtyIndices.push_back(range);
+
+	// the generation wrapped, retire the slot rather than hand out a handle equal to an old one
+	if (shape->generation > HANDLE_GENERATION_MASK) {
+		return;
+	}
+	m_freeSlots[shape->vertexCount].push_back((int)(shape - &m_shapes[0]));
+}
+
+bool ShapePool::isValid(ShapeHandle handle) const {
+	unsigned int slot = (handle & HANDLE_INDEX_MASK);
+	if (slot == 0 || slot > m_shapes.size()) {
+		return false;
+	}
+	const Shape& shape = m_shapes[slot - 1];
+	return shape.alive && shape.generation == (handle >> HANDLE_INDEX_BITS);
+}
+
+ShapePool::Shape* ShapePool::lookup(ShapeHandle handle) {
+	if (!isValid(handle)) {
+		return nullptr;
+	}
+	return &m_shapes[(handle & HANDLE_INDEX_MASK) - 1];
+}
+
+void ShapePool::writeShape(const Shape& shape, const float* points) {
+	float bounds[] = { points[0], points[1], points[0], points[1] };
+	for (int i = 0; i < shape.vertexCount; ++i) {
+		Renderer2D::Vertex& v = m_vertices[shape.firstVertex + i];
+		v.pos[0] = points[i * 2 + 0];
+		v.pos[1] = points[i * 2 + 1];
+		v.pos[2] = 0.0f;
+		bounds[0] = std::min(bounds[0], v.pos[0]);
+		bounds[1] = std::min(bounds[1], v.pos[1]);
+		bounds[2] = std::max(bounds[2], v.pos[0]);
+		bounds[3] = std::max(bounds[3], v.pos[1]);
+	}
+	// inserts the shape the first time, afterwards only crossing into other cells costs more than a copy
+	m_grid.move((unsigned int)(&shape - &m_shapes[0]), bounds);
+
+	// convex polygons are drawn as a fan around the first point
+	unsigned int* index = &m_indices[shape.firstIndex];
+	for (int i = 1; i < shape.vertexCount - 1; ++i) {
+		*index++ = shape.firstVertex;
+		*index++ = shape.firstVertex + i;
+		*index++ = shape.firstVertex + i + 1;
+	}
+
+	Range vertices = { shape.firstVertex, shape.firstVertex + shape.vertexCount };
+	m_dirtyVertices.push_back(vertices);
+	Range indices = { shape.firstIndex, shape.firstIndex + shape.indexCount };
+	m_dirtyIndices.push_back(indices);
+}
+
+void ShapePool::reserve() {
+	if ((int)m_vertices.size() <= m_vertexCapacity && (int)m_indices.size() <= m_indexCapacity) {
+		return;
+	}
+	// grow geometrically and upload everything once, nothing is dirty afterwards
+	m_vertexCapacity = std::max((int)m_vertices.size(), m_vertexCapacity * 2);
+	m_indexCapacity = std::max((int)m_indices.size(), m_indexCapacity * 2);
+
+	allocate(m_VBO, GL_ARRAY_BUFFER, (long long)sizeof(Renderer2D::Vertex) * m_vertexCapacity,
+		m_vertices.data(), (long long)sizeof(Renderer2D::Vertex) * m_vertices.size());
+	allocate(m_EBO, GL_ELEMENT_ARRAY_BUFFER, (long long)sizeof(unsigned int) * m_indexCapacity,
+		m_indices.data(), (long long)sizeof(unsigned int) * m_indices.size());
+
+	m_dirtyVertices.clear();
+	m_dirtyIndices.clear();
+}
+
+void ShapePool::allocate(unsigned int buffer, unsigned int target, long long size, const void* data, long long dataSize) {
+	if (m_directStateAccess) {
+		glNamedBufferData(buffer, (GLsizeiptr)size, nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferSubData(buffer, 0, (GLsizeiptr)dataSize, data);
+		return;
+	}
+	glBindBuffer(target, buffer);
+	glBufferData(target, (GLsizeiptr)size, nullptr, GL_DYNAMIC_DRAW);
+	glBufferSubData(target, 0, (GLsizeiptr)dataSize, data);
+}
+
+void ShapePool::flushRanges(std::vector<Range>& ranges, unsigned int buffer, unsigned int target, int elementSize, const void* data) {
+	if (ranges.empty()) {
+		return;
+	}
+	std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+	if (!m_directStateAccess) {
+		glBindBuffer(target, buffer);
+	}
+
+	// coalesce overlapping and nearby ranges, uploading a small gap is cheaper than another call
+	Range current = ranges[0];
+	for (size_t i = 1; i <= ranges.size(); ++i) {
+		if (i < ranges.size() && ranges[i].begin <= current.end + MERGE_GAP) {
+			current.end = std::max(current.end, ranges[i].end);
+			continue;
+		}
+		GLintptr offset = (GLintptr)current.begin * elementSize;
+		GLsizeiptr size = (GLsizeiptr)(current.end - current.begin) * elementSize;
+		const char* source = (const char*)data + (size_t)current.begin * elementSize;
+		if (m_directStateAccess) {
+			glNamedBufferSubData(buffer, offset, size, source);
+		}
+		else {
+			glBufferSubData(target, offset, size, source);
+		}
+		if (i < ranges.size()) {
+			current = ranges[i];
+		}
+	}
+	ranges.clear();
+}
+
+void ShapePool::draw(const float* bounds) {
+	if (m_indices.empty()) {
+		return;
+	}
+
+	// only the shapes in the cells under bounds are looked at
+	m_visible.clear();
+	if (bounds != nullptr) {
+		m_grid.query(bounds, m_visible);
+	}
+
+	glBindVertexArray(m_VAO);
+
+	reserve();
+	flushRanges(m_dirtyVertices, m_VBO, GL_ARRAY_BUFFER, sizeof(Renderer2D::Vertex), m_vertices.data());
+	flushRanges(m_dirtyIndices, m_EBO, GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int), m_indices.data());
+
+	if (bounds == nullptr || (int)m_visible.size() == m_liveShapes) {
+		updateDrawOrder();
+		if (m_slotsInOrder) {
+			// everything is visible in creation order, the dead ranges are collapsed and draw nothing
+			glDrawElements(GL_TRIANGLES, (GLsizei)m_indices.size(), GL_UNSIGNED_INT, 0);
+		}
+		else {
+			drawSlots(m_drawOrder);
+		}
+	}
+	else if (!m_visible.empty()) {
+		drawVisible();
+	}
+	glBindVertexArray(0);
+}
+
+void ShapePool::drawVisible() {
+	// sorted by creation, not by slot, a reused slot holds a newer shape than the slots after it
+	std::sort(m_visible.begin(), m_visible.end(),
+		[this](unsigned int a, unsigned int b) { return m_shapes[a].sequence < m_shapes[b].sequence; });
+	drawSlots(m_visible);
+}
+
+void ShapePool::drawSlots(const std::vector<unsigned int>& slots) {
+	m_drawCounts.clear();
+	m_drawOffsets.clear();
+	int end = -1;
+	for (size_t i = 0; i < slots.size(); ++i) {
+		const Shape& shape = m_shapes[slots[i]];
+		// shapes created one after another have adjacent index ranges
+		if (shape.firstIndex == end) {
+			m_drawCounts.back() += shape.indexCount;
+		}
+		else {
+			m_drawCounts.push_back(shape.indexCount);
+			m_drawOffsets.push_back((char*)0 + shape.firstIndex * sizeof(unsigned int));
+		}
+		end = shape.firstIndex + shape.indexCount;
+	}
+
+	glMultiDrawElements(GL_TRIANGLES, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(), (GLsizei)m_drawCounts.size());
+}
+
+void ShapePool::updateDrawOrder() {
+	if (!m_drawOrderDirty) {
+		return;
+	}
+	m_drawOrderDirty = false;
+
+	m_drawOrder.clear();
+	for (size_t i = 0; i < m_shapes.size(); ++i) {
+		if (m_shapes[i].alive) {
+			m_drawOrder.push_back((unsigned int)i);
+		}
+	}
+	std::sort(m_drawOrder.begin(), m_drawOrder.end(),
+		[this](unsigned int a, unsigned int b) { return m_shapes[a].sequence < m_shapes[b].sequence; });
+
+	// a slot reused by a newer shape ahead of older ones breaks the order of the buffers
+	m_slotsInOrder = std::is_sorted(m_drawOrder.begin(), m_drawOrder.end());
+}
+
+ShapePool::~ShapePool() {
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteBuffers(1, &m_EBO);
+}
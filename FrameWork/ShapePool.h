@@ -0,0 +1,137 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: ShapePool.h
+*
+* Description:	GPU resident pool of retained shapes.
+*				Shapes are addressed by handles, only the vertex and index ranges of
+*				changed shapes are uploaded and the visible shapes are drawn with one call.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef SHAPEPOOL_H_
+#define SHAPEPOOL_H_
+
+#include "Renderer2D.h"
+#include "SpatialGrid.h"
+#include <map>
+#include <vector>
+
+class ShapePool {
+public:
+	// @param directStateAccess - edit the buffers through glNamedBuffer* instead of binding them
+	explicit ShapePool(bool directStateAccess);
+
+	// adds a convex polygon to the pool
+	// @param points x, y pairs in winding order
+	// @param count number of points
+	// @param color rgba colour of every vertex
+	// @return 0, an invalid handle, once the pool holds as many slots as a handle can address
+	ShapeHandle create(const float* points, int count, const float* color);
+
+	// moves the points of a shape, count must match the count it was created with
+	void update(ShapeHandle handle, const float* points, int count);
+
+	// changes the colour of a shape
+	void setColor(ShapeHandle handle, const float* color);
+
+	// removes a shape from the pool, the handle becomes invalid
+	void destroy(ShapeHandle handle);
+
+	// true if the handle refers to a live shape
+	bool isValid(ShapeHandle handle) const;
+
+	// uploads the dirty ranges and draws the shapes overlapping bounds
+	// @param bounds min x, min y, max x, max y, or nullptr to draw every shape
+	void draw(const float* bounds);
+
+	~ShapePool();
+
+protected:
+	enum {
+		// ranges closer than this many elements are merged into one upload
+		MERGE_GAP = 64,
+		// cell size of the visibility grid in world units
+		CELL_SIZE = 128
+	};
+
+	struct Shape {
+		int firstVertex;
+		int vertexCount;
+		int firstIndex;
+		int indexCount;
+		unsigned int generation;
+		// creation order, a reused slot gets a newer sequence than the slots after it
+		unsigned long long sequence;
+		bool alive;
+	};
+
+	struct Range {
+		int begin;
+		int end;
+	};
+
+	Shape* lookup(ShapeHandle handle);
+
+	// writes the positions and the fan indices of a shape
+	void writeShape(const Shape& shape, const float* points);
+
+	// uploads the coalesced dirty ranges of one buffer
+	void flushRanges(std::vector<Range>& ranges, unsigned int buffer, unsigned int target, int elementSize, const void* data);
+
+	// replaces the data store of a buffer
+	void allocate(unsigned int buffer, unsigned int target, long long size, const void* data, long long dataSize);
+
+	// grows the GPU buffers to fit the CPU copy
+	void reserve();
+
+	// draws the index ranges of the visible shapes in creation order, merging neighbouring ranges
+	void drawVisible();
+
+	// draws the index ranges of slots in the order given, merging neighbouring ranges
+	void drawSlots(const std::vector<unsigned int>& slots);
+
+	// sorts the live slots by creation after shapes were created or destroyed
+	void updateDrawOrder();
+
+	unsigned int m_VAO, m_VBO, m_EBO;
+	bool m_directStateAccess;
+
+	std::vector<Renderer2D::Vertex> m_vertices;
+	std::vector<unsigned int> m_indices;
+
+	std::vector<Shape> m_shapes;
+
+	// dead shape slots, keyed by their vertex count
+	std::map<int, std::vector<int>> m_freeSlots;
+
+	std::vector<Range> m_dirtyVertices;
+	std::vector<Range> m_dirtyIndices;
+
+	int m_vertexCapacity;
+	int m_indexCapacity;
+
+	// bounds of the live shapes, keyed by slot
+	SpatialGrid m_grid;
+	int m_liveShapes;
+
+	// live slots in creation order, the order overlapping shapes are painted in
+	std::vector<unsigned int> m_drawOrder;
+	bool m_drawOrderDirty;
+	// true while the slots of the live shapes are in creation order, so one call draws them all
+	bool m_slotsInOrder;
+	unsigned long long m_nextSequence;
+
+	// per draw scratch, kept to avoid allocating every frame
+	std::vector<unsigned int> m_visible;
+	std::vector<int> m_drawCounts;
+	std::vector<const void*> m_drawOffsets;
+};
+
+#endif // !SHAPEPOOL_H_
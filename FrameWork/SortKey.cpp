@@ -0,0 +1,96 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: SortKey.cpp
+*
+* Description:	64-bit sort keys of queued primitives and the radix sort that orders them,
+*				so submission groups by draw state while layers and blending stay correct.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "SortKey.h"
+#include "Renderer2D.h"
+#include <algorithm>
+
+unsigned long long SortKey::make(unsigned int pipeline, unsigned int texture, int blendMode, int layer,
+	unsigned int depthKey, unsigned long long sequence) {
+	unsigned long long key = 0;
+
+	if (blendMode == Renderer2D::BLEND_OPAQUE) {
+		// opaque primitives are depth tested, so they are grouped by state
+		// and drawn front to back inside each group
+		key |= (unsigned long long)(pipeline & 0x3F) << 57;
+		key |= (unsigned long long)(texture & 0xFFFF) << 41;
+		key |= (unsigned long long)(depthKey & 0x7FFFFF) << 18;
+		return key;
+	}
+
+	// translucent primitives follow the opaque ones, back to front by layer
+	key |= 1ull << 63;
+	key |= (unsigned long long)(layer & 0xFF) << 55;
+	key |= (unsigned long long)(blendMode & 0x3) << 53;
+	if (blendMode == Renderer2D::BLEND_ALPHA) {
+		// alpha blending depends on the order, so the submission order is kept
+		// above the state bits and only equal neighbours are merged
+		key |= (sequence & 0xFFFFFF) << 29;
+		key |= (unsigned long long)(pipeline & 0x3F) << 23;
+		key |= (unsigned long long)(texture & 0xFFFF) << 7;
+	}
+	else {
+		// additive blending is order independent, group it by state
+		key |= (unsigned long long)(pipeline & 0x3F) << 47;
+		key |= (unsigned long long)(texture & 0xFFFF) << 31;
+		key |= (sequence & 0xFFFFFF) << 7;
+	}
+	return key;
+}
+
+void SortKey::radixSort(unsigned long long* keys, unsigned int* values,
+	unsigned long long* tmpKeys, unsigned int* tmpValues, size_t count) {
+	if (count == 0) {
+		return;
+	}
+
+	// least significant byte first, every pass is a stable counting sort,
+	// passes where all keys share the same byte are skipped
+	unsigned long long* srcKeys = keys;
+	unsigned int* srcValues = values;
+	unsigned long long* dstKeys = tmpKeys;
+	unsigned int* dstValues = tmpValues;
+
+	for (int shift = 0; shift < 64; shift += 8) {
+		size_t histogram[256] = { 0 };
+		for (size_t i = 0; i < count; ++i) {
+			histogram[(srcKeys[i] >> shift) & 0xFF]++;
+		}
+		if (histogram[(srcKeys[0] >> shift) & 0xFF] == count) {
+			continue;
+		}
+
+		size_t offset = 0;
+		for (int i = 0; i < 256; ++i) {
+			size_t bucket = histogram[i];
+			histogram[i] = offset;
+			offset += bucket;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			size_t slot = histogram[(srcKeys[i] >> shift) & 0xFF]++;
+			dstKeys[slot] = srcKeys[i];
+			dstValues[slot] = srcValues[i];
+		}
+
+		std::swap(srcKeys, dstKeys);
+		std::swap(srcValues, dstValues);
+	}
+
+	if (srcKeys != keys) {
+		std::copy(srcKeys, srcKeys + count, keys);
+		std::copy(srcValues, srcValues + count, values);
+	}
+}
@@ -0,0 +1,40 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: SortKey.h
+*
+* Description:	64-bit sort keys of queued primitives and the radix sort that orders them,
+*				so submission groups by draw state while layers and blending stay correct.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef SORTKEY_H_
+#define SORTKEY_H_
+
+#include <cstddef>
+
+namespace SortKey {
+	// builds the sort key of a primitive
+	// opaque: bit 63 clear, 57-62 pipeline, 41-56 texture, 18-40 depth front to back
+	// translucent: bit 63 set, 55-62 layer, 53-54 blend mode, then
+	// for alpha 29-52 submission order, 23-28 pipeline, 7-22 texture
+	// for additive 47-52 pipeline, 31-46 texture, 7-30 submission order
+	// @param blendMode - a Renderer2D::BlendMode
+	// @param depthKey - larger is farther from the camera
+	// @param sequence - submission order within the frame
+	unsigned long long make(unsigned int pipeline, unsigned int texture, int blendMode, int layer,
+		unsigned int depthKey, unsigned long long sequence);
+
+	// sorts keys together with their values, equal keys keep their order
+	// @param tmpKeys, tmpValues - scratch space of count entries
+	void radixSort(unsigned long long* keys, unsigned int* values,
+		unsigned long long* tmpKeys, unsigned int* tmpValues, size_t count);
+}
+
+#endif // !SORTKEY_H_
@@ -0,0 +1,208 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: SpatialGrid.cpp
+*
+* Description:	Uniform grid over axis aligned bounds, with only the occupied cells stored in a hash map.
+*				Items are inserted, moved and removed one at a time and a rectangle query
+*				only visits the cells it covers, so its cost follows the visible items.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "SpatialGrid.h"
+#include <algorithm>
+
+namespace {
+	// cell coordinates beyond this are not stored, which keeps them well inside int
+	const float MAX_CELL = 1e9f;
+
+	inline bool overlaps(const float* a, const float* b) {
+		return a[2] >= b[0] && a[3] >= b[1] && a[0] <= b[2] && a[1] <= b[3];
+	}
+
+	// removes one id from a cell without keeping the order
+	inline void erase(std::vector<unsigned int>& cell, unsigned int id) {
+		std::vector<unsigned int>::iterator it = std::find(cell.begin(), cell.end(), id);
+		if (it != cell.end()) {
+			*it = cell.back();
+			cell.pop_back();
+		}
+	}
+}
+
+SpatialGrid::SpatialGrid(float cellSize) {
+	m_cellSize = glm::max(cellSize, 1e-6f);
+	m_inverseCellSize = 1.0f / m_cellSize;
+	m_stamp = 0;
+}
+
+bool SpatialGrid::cellRange(const float* bounds, glm::ivec4& cells) const {
+	glm::vec4 range = glm::floor(glm::vec4(bounds[0], bounds[1], bounds[2], bounds[3]) * m_inverseCellSize);
+	// also false for NaN and infinite bounds
+	if (!(glm::abs(range.x) < MAX_CELL && glm::abs(range.y) < MAX_CELL && glm::abs(range.z) < MAX_CELL && glm::abs(range.w) < MAX_CELL)) {
+		return false;
+	}
+	cells = glm::ivec4(range);
+	return (double)(cells.z - cells.x + 1) * (double)(cells.w - cells.y + 1) <= MAX_ITEM_CELLS;
+}
+
+void SpatialGrid::insert(unsigned int id, const float* bounds) {
+	if (id >= m_items.size()) {
+		Item empty = {};
+		m_items.resize(id + 1, empty);
+	}
+	if (m_items[id].alive) {
+		move(id, bounds);
+		return;
+	}
+
+	Item& item = m_items[id];
+	std::copy(bounds, bounds + 4, item.bounds);
+	item.alive = true;
+	item.large = !cellRange(bounds, item.cells);
+	if (item.large) {
+		m_large.push_back(id);
+	}
+	else {
+		link(id, item.cells);
+	}
+}
+
+void SpatialGrid::move(unsigned int id, const float* bounds) {
+	if (!contains(id)) {
+		insert(id, bounds);
+		return;
+	}
+
+	Item& item = m_items[id];
+	std::copy(bounds, bounds + 4, item.bounds);
+	glm::ivec4 cells;
+	bool large = !cellRange(bounds, cells);
+
+	// most moves stay inside the same cells and only update the bounds
+	if (large == item.large && (large || cells == item.cells)) {
+		return;
+	}
+	if (item.large) {
+		removeLarge(id);
+	}
+	else {
+		unlink(id, item.cells);
+	}
+	item.large = large;
+	item.cells = cells;
+	if (large) {
+		m_large.push_back(id);
+	}
+	else {
+		link(id, cells);
+	}
+}
+
+void SpatialGrid::remove(unsigned int id) {
+	if (!contains(id)) {
+		return;
+	}
+	Item& item = m_items[id];
+	if (item.large) {
+		removeLarge(id);
+	}
+	else {
+		unlink(id, item.cells);
+	}
+	item.alive = false;
+}
+
+bool SpatialGrid::contains(unsigned int id) const {
+	return id < m_items.size() && m_items[id].alive;
+}
+
+void SpatialGrid::query(const float* bounds, std::vector<unsigned int>& ids) {
+	// a new stamp marks every item as not yet reported
+	if (++m_stamp == 0) {
+		for (size_t i = 0; i < m_items.size(); ++i) {
+			m_items[i].stamp = 0;
+		}
+		m_stamp = 1;
+	}
+
+	for (size_t i = 0; i < m_large.size(); ++i) {
+		visit(m_large[i], bounds, ids);
+	}
+
+	glm::vec4 range = glm::floor(glm::vec4(bounds[0], bounds[1], bounds[2], bounds[3]) * m_inverseCellSize);
+	double area = ((double)range.z - range.x + 1.0) * ((double)range.w - range.y + 1.0);
+	bool inside = glm::abs(range.x) < MAX_CELL && glm::abs(range.y) < MAX_CELL && glm::abs(range.z) < MAX_CELL && glm::abs(range.w) < MAX_CELL;
+	if (!inside || !(area <= (double)m_cells.size())) {
+		// the rectangle covers more cells than are occupied, or is too far out to step
+		// through cell by cell, so walk the occupied cells instead
+		for (std::unordered_map<glm::ivec2, std::vector<unsigned int>>::const_iterator it = m_cells.begin(); it != m_cells.end(); ++it) {
+			glm::vec2 cell(it->first);
+			if (cell.x < range.x || cell.y < range.y || cell.x > range.z || cell.y > range.w) {
+				continue;
+			}
+			for (size_t i = 0; i < it->second.size(); ++i) {
+				visit(it->second[i], bounds, ids);
+			}
+		}
+		return;
+	}
+
+	glm::ivec4 cells(range);
+	for (int y = cells.y; y <= cells.w; ++y) {
+		for (int x = cells.x; x <= cells.z; ++x) {
+			std::unordered_map<glm::ivec2, std::vector<unsigned int>>::const_iterator it = m_cells.find(glm::ivec2(x, y));
+			if (it == m_cells.end()) {
+				continue;
+			}
+			for (size_t i = 0; i < it->second.size(); ++i) {
+				visit(it->second[i], bounds, ids);
+			}
+		}
+	}
+}
+
+void SpatialGrid::link(unsigned int id, const glm::ivec4& cells) {
+	for (int y = cells.y; y <= cells.w; ++y) {
+		for (int x = cells.x; x <= cells.z; ++x) {
+			m_cells[glm::ivec2(x, y)].push_back(id);
+		}
+	}
+}
+
+void SpatialGrid::unlink(unsigned int id, const glm::ivec4& cells) {
+	for (int y = cells.y; y <= cells.w; ++y) {
+		for (int x = cells.x; x <= cells.z; ++x) {
+			std::unordered_map<glm::ivec2, std::vector<unsigned int>>::iterator it = m_cells.find(glm::ivec2(x, y));
+			if (it == m_cells.end()) {
+				continue;
+			}
+			erase(it->second, id);
+			// empty cells are dropped so the map only holds occupied ones
+			if (it->second.empty()) {
+				m_cells.erase(it);
+			}
+		}
+	}
+}
+
+void SpatialGrid::removeLarge(unsigned int id) {
+	erase(m_large, id);
+}
+
+void SpatialGrid::visit(unsigned int id, const float* bounds, std::vector<unsigned int>& ids) {
+	Item& item = m_items[id];
+	if (item.stamp == m_stamp) {
+		return;
+	}
+	item.stamp = m_stamp;
+	if (overlaps(item.bounds, bounds)) {
+		ids.push_back(id);
+	}
+}
@@ -0,0 +1,86 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: SpatialGrid.h
+*
+* Description:	Uniform grid over axis aligned bounds, with only the occupied cells stored in a hash map.
+*				Items are inserted, moved and removed one at a time and a rectangle query
+*				only visits the cells it covers, so its cost follows the visible items.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#define GLM_ENABLE_EXPERIMENTAL
+#endif
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+#include <unordered_map>
+#include <vector>
+
+class SpatialGrid {
+public:
+	// @param cellSize - width and height of a cell in world units,
+	//                   about the size of a typical item works best
+	explicit SpatialGrid(float cellSize);
+
+	// bounds are min x, min y, max x, max y
+	// @param id - caller chosen item id, ids are used as indices so keep them small and dense
+	void insert(unsigned int id, const float* bounds);
+
+	// updates the bounds of an item, cells are only touched when it crosses into other cells
+	void move(unsigned int id, const float* bounds);
+
+	void remove(unsigned int id);
+
+	bool contains(unsigned int id) const;
+
+	// appends the ids of the items overlapping bounds, each id once, in no particular order
+	void query(const float* bounds, std::vector<unsigned int>& ids);
+
+protected:
+	enum {
+		// items covering more cells than this are kept in a list of their own
+		// and tested on every query, so huge items do not flood the grid
+		MAX_ITEM_CELLS = 16
+	};
+
+	struct Item {
+		float bounds[4];
+		// covered cells, min x, min y, max x, max y
+		glm::ivec4 cells;
+		// query that last reported the item, to report items in several cells once
+		unsigned int stamp;
+		bool alive;
+		bool large;
+	};
+
+	// cells covered by bounds, false when they are too many to store the item in the grid
+	bool cellRange(const float* bounds, glm::ivec4& cells) const;
+
+	void link(unsigned int id, const glm::ivec4& cells);
+	void unlink(unsigned int id, const glm::ivec4& cells);
+	void removeLarge(unsigned int id);
+
+	// tests an item against the query and reports it once
+	void visit(unsigned int id, const float* bounds, std::vector<unsigned int>& ids);
+
+	float m_cellSize;
+	float m_inverseCellSize;
+
+	std::vector<Item> m_items;
+	std::unordered_map<glm::ivec2, std::vector<unsigned int>> m_cells;
+	std::vector<unsigned int> m_large;
+
+	unsigned int m_stamp;
+};
+
+#endif // !SPATIALGRID_H_
@@ -0,0 +1,289 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Stroke.cpp
+*
+* Description:	Tessellates lines and polylines of any width into triangles,
+*				so strokes batch with the other triangles instead of using glLineWidth.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Stroke.h"
+#include <glm/gtc/constants.hpp>
+
+namespace {
+	// left normal of a direction
+	inline glm::vec2 perp(const glm::vec2& d) {
+		return glm::vec2(-d.y, d.x);
+	}
+}
+
+Stroke::Stroker::Stroker() {
+	Style style = { 1.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_BUTT, 1.0f };
+	Output output = { nullptr, nullptr, 0, 0.0f, nullptr, 0, 0 };
+	m_output = output;
+	begin(style, false);
+}
+
+void Stroke::Stroker::begin(const Style& style, bool closed) {
+	m_style = style;
+	m_thin = style.width * style.pixelsPerUnit <= 1.0f;
+	m_closed = closed;
+	m_points = 0;
+	m_hasPrevious = false;
+	m_firstEnded = false;
+}
+
+void Stroke::Stroker::setOutput(const Output& output) {
+	// read the carried edge before the new output possibly overwrites it
+	glm::vec2 left, right;
+	if (m_hasPrevious) {
+		left = position(m_previous.left);
+		right = position(m_previous.right);
+	}
+
+	m_output = output;
+	if (m_hasPrevious) {
+		m_previous.left = vertex(left);
+		m_previous.right = vertex(right);
+	}
+}
+
+void Stroke::Stroker::addPoint(float x, float y) {
+	glm::vec2 p(x, y);
+	if (m_points == 0) {
+		m_first = p;
+		m_last = p;
+		m_points = 1;
+		return;
+	}
+	if (p == m_last) {
+		return;
+	}
+
+	glm::vec2 d = glm::normalize(p - m_last);
+	if (m_points == 1) {
+		m_firstDir = d;
+		if (!m_closed) {
+			m_previous = startCap(m_first, d);
+			m_hasPrevious = true;
+		}
+	}
+	else {
+		Pair end, start;
+		join(m_last, m_dir, d, end, start);
+		endSegment(end);
+		m_previous = start;
+		m_hasPrevious = true;
+	}
+
+	m_dir = d;
+	m_last = p;
+	m_points++;
+}
+
+void Stroke::Stroker::end() {
+	if (m_points < 2) {
+		m_points = 0;
+		return;
+	}
+
+	if (!m_closed) {
+		endSegment(endCap(m_last, m_dir));
+	}
+	else {
+		Pair end, start;
+		// the segment back to the first point, unless the last point already repeats it
+		if (m_last != m_first) {
+			glm::vec2 d = glm::normalize(m_first - m_last);
+			join(m_last, m_dir, d, end, start);
+			endSegment(end);
+			m_previous = start;
+			m_hasPrevious = true;
+			m_dir = d;
+		}
+		join(m_first, m_dir, m_firstDir, end, start);
+		endSegment(end);
+
+		// the first segment, from the closing join to its stored end
+		Pair firstEnd = { vertex(m_firstEnd[0]), vertex(m_firstEnd[1]) };
+		m_previous = start;
+		endSegment(firstEnd);
+	}
+
+	m_points = 0;
+	m_hasPrevious = false;
+}
+
+unsigned int Stroke::Stroker::vertex(const glm::vec2& p) {
+	Renderer2D::Vertex& v = m_output.vertices[m_output.vertexCount];
+	v.pos[0] = p.x;
+	v.pos[1] = p.y;
+	v.pos[2] = m_output.depth;
+	v.color[0] = m_output.color[0];
+	v.color[1] = m_output.color[1];
+	v.color[2] = m_output.color[2];
+	v.color[3] = m_output.color[3];
+	return m_output.firstVertex + m_output.vertexCount++;
+}
+
+glm::vec2 Stroke::Stroker::position(unsigned int vertex) const {
+	const Renderer2D::Vertex& v = m_output.vertices[vertex - m_output.firstVertex];
+	return glm::vec2(v.pos[0], v.pos[1]);
+}
+
+void Stroke::Stroker::triangle(unsigned int a, unsigned int b, unsigned int c) {
+	m_output.indices[m_output.indexCount++] = a;
+	m_output.indices[m_output.indexCount++] = b;
+	m_output.indices[m_output.indexCount++] = c;
+}
+
+void Stroke::Stroker::fan(unsigned int center, unsigned int previous, unsigned int next, float angle) {
+	if (angle > 0.0f) {
+		triangle(center, next, previous);
+	}
+	else {
+		triangle(center, previous, next);
+	}
+}
+
+void Stroke::Stroker::arc(const glm::vec2& center, const glm::vec2& offset, float angle, unsigned int first, unsigned int last) {
+	unsigned int c = vertex(center);
+	int steps = (int)glm::ceil(glm::abs(angle) / (glm::pi<float>() / ROUND_SEGMENTS));
+	steps = glm::clamp(steps, 1, (int)ROUND_SEGMENTS);
+
+	unsigned int previous = first;
+	for (int i = 1; i < steps; ++i) {
+		float a = angle * (float)i / (float)steps;
+		float s = glm::sin(a);
+		float co = glm::cos(a);
+		unsigned int next = vertex(center + glm::vec2(offset.x * co - offset.y * s, offset.x * s + offset.y * co));
+		fan(c, previous, next, angle);
+		previous = next;
+	}
+	fan(c, previous, last, angle);
+}
+
+Stroke::Stroker::Pair Stroke::Stroker::startCap(const glm::vec2& p, const glm::vec2& d) {
+	float halfWidth = m_style.width * 0.5f;
+	glm::vec2 n = perp(d) * halfWidth;
+	glm::vec2 base = (m_style.cap == Renderer2D::CAP_SQUARE && !m_thin ? p - d * halfWidth : p);
+
+	Pair pair;
+	pair.left = vertex(base + n);
+	pair.right = vertex(base - n);
+	if (m_style.cap == Renderer2D::CAP_ROUND && !m_thin) {
+		// half circle behind the start, from the left edge round to the right edge
+		arc(p, n, glm::pi<float>(), pair.left, pair.right);
+	}
+	return pair;
+}
+
+Stroke::Stroker::Pair Stroke::Stroker::endCap(const glm::vec2& p, const glm::vec2& d) {
+	float halfWidth = m_style.width * 0.5f;
+	glm::vec2 n = perp(d) * halfWidth;
+	glm::vec2 base = (m_style.cap == Renderer2D::CAP_SQUARE && !m_thin ? p + d * halfWidth : p);
+
+	Pair pair;
+	pair.left = vertex(base + n);
+	pair.right = vertex(base - n);
+	if (m_style.cap == Renderer2D::CAP_ROUND && !m_thin) {
+		arc(p, -n, glm::pi<float>(), pair.right, pair.left);
+	}
+	return pair;
+}
+
+void Stroke::Stroker::join(const glm::vec2& p, const glm::vec2& d0, const glm::vec2& d1, Pair& end, Pair& start) {
+	float halfWidth = m_style.width * 0.5f;
+	glm::vec2 n0 = perp(d0);
+	glm::vec2 n1 = perp(d1);
+	float cross = d0.x * d1.y - d0.y * d1.x;
+	float dot = glm::dot(d0, d1);
+
+	// nearly straight, any join looks the same
+	if (glm::abs(cross) < 1e-4f && dot > 0.0f) {
+		end.left = vertex(p + n0 * halfWidth);
+		end.right = vertex(p - n0 * halfWidth);
+		start = end;
+		return;
+	}
+
+	// a stroke a pixel wide on screen skips the joins, both segments share an edge along the averaged normal
+	if (m_thin) {
+		glm::vec2 n = (1.0f + dot > 1e-4f ? glm::normalize(n0 + n1) : n0) * halfWidth;
+		end.left = vertex(p + n);
+		end.right = vertex(p - n);
+		start = end;
+		return;
+	}
+
+	// the miter offset reaches the intersection of the two edges, |offset| = halfWidth / cos(turn / 2)
+	if (m_style.join == Renderer2D::JOIN_MITER && 1.0f + dot > 1e-4f) {
+		glm::vec2 miter = (n0 + n1) * (halfWidth / (1.0f + dot));
+		if (glm::dot(miter, miter) <= MITER_LIMIT * MITER_LIMIT * halfWidth * halfWidth) {
+			end.left = vertex(p + miter);
+			end.right = vertex(p - miter);
+			start = end;
+			return;
+		}
+	}
+
+	end.left = vertex(p + n0 * halfWidth);
+	end.right = vertex(p - n0 * halfWidth);
+	start.left = vertex(p + n1 * halfWidth);
+	start.right = vertex(p - n1 * halfWidth);
+
+	// a left turn opens a gap on the right edge and the other way round,
+	// the inner edges of the two segments overlap
+	bool leftTurn = cross > 0.0f;
+	unsigned int from = (leftTurn ? end.right : end.left);
+	unsigned int to = (leftTurn ? start.right : start.left);
+	if (m_style.join == Renderer2D::JOIN_ROUND) {
+		glm::vec2 offset = (leftTurn ? -n0 : n0) * halfWidth;
+		arc(p, offset, glm::atan(cross, dot), from, to);
+	}
+	else {
+		fan(vertex(p), from, to, leftTurn ? 1.0f : -1.0f);
+	}
+}
+
+void Stroke::Stroker::endSegment(const Pair& end) {
+	if (m_closed && !m_firstEnded) {
+		m_firstEnd[0] = position(end.left);
+		m_firstEnd[1] = position(end.right);
+		m_firstEnded = true;
+		return;
+	}
+	triangle(m_previous.left, end.left, end.right);
+	triangle(m_previous.left, end.right, m_previous.right);
+}
+
+int Stroke::maxVertices(int count) {
+	return count * POINT_VERTICES + END_VERTICES;
+}
+
+int Stroke::maxIndices(int count) {
+	return count * POINT_INDICES + END_INDICES;
+}
+
+void Stroke::polyline(Renderer2D::Vertex* vertices, unsigned int* indices, unsigned int firstVertex,
+	const float* points, int count, bool closed, const Style& style, float depth, const float* color,
+	int& vertexCount, int& indexCount) {
+	Output output = { vertices, indices, firstVertex, depth, color, 0, 0 };
+	Stroker stroker;
+	stroker.begin(style, closed);
+	stroker.setOutput(output);
+	for (int i = 0; i < count; ++i) {
+		stroker.addPoint(points[i * 2 + 0], points[i * 2 + 1]);
+	}
+	stroker.end();
+
+	vertexCount = stroker.getOutput().vertexCount;
+	indexCount = stroker.getOutput().indexCount;
+}
@@ -0,0 +1,141 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Stroke.h
+*
+* Description:	Tessellates lines and polylines of any width into triangles,
+*				so strokes batch with the other triangles instead of using glLineWidth.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef STROKE_H_
+#define STROKE_H_
+
+#include "Renderer2D.h"
+#include <glm/glm.hpp>
+
+namespace Stroke {
+	enum {
+		// arc segments of a half circle in round joins and caps
+		ROUND_SEGMENTS = 8,
+		// most vertices and indices written by one addPoint
+		POINT_VERTICES = ROUND_SEGMENTS + 4,
+		POINT_INDICES = ROUND_SEGMENTS * 3 + 6,
+		// most vertices and indices written by end, including the closing joins of a closed polyline
+		END_VERTICES = ROUND_SEGMENTS * 2 + 10,
+		END_INDICES = ROUND_SEGMENTS * 6 + 18
+	};
+
+	// miters longer than this many half widths fall back to a bevel
+	const float MITER_LIMIT = 4.0f;
+
+	struct Style {
+		// width in world units
+		float width;
+		Renderer2D::LineJoin join;
+		Renderer2D::LineCap cap;
+		// framebuffer pixels per world unit, strokes of 1 pixel or less on screen skip the joins and caps
+		float pixelsPerUnit;
+	};
+
+	// where the stroke writes its vertices and indices
+	struct Output {
+		Renderer2D::Vertex* vertices;
+		unsigned int* indices;
+		// index of vertices[0] in the vertex buffer
+		unsigned int firstVertex;
+		float depth;
+		const float* color;
+		// written so far
+		int vertexCount;
+		int indexCount;
+	};
+
+	// tessellates a polyline point by point, so a series of any length
+	// can be streamed through a fixed size buffer
+	class Stroker {
+	public:
+		Stroker();
+
+		void begin(const Style& style, bool closed);
+
+		// continues writing into another buffer, the edge of the last
+		// point is written again so the stroke has no seam
+		void setOutput(const Output& output);
+
+		// adds the next point, repeated points are skipped
+		void addPoint(float x, float y);
+
+		// caps or closes the polyline, fewer than 2 distinct points write nothing
+		void end();
+
+		const Output& getOutput() const { return m_output; }
+
+	protected:
+		// left and right edge vertices of the stroke at a point
+		struct Pair {
+			unsigned int left, right;
+		};
+
+		unsigned int vertex(const glm::vec2& p);
+		glm::vec2 position(unsigned int vertex) const;
+		void triangle(unsigned int a, unsigned int b, unsigned int c);
+
+		// triangle of a wedge, wound clockwise like the rest of the stroke
+		void fan(unsigned int center, unsigned int previous, unsigned int next, float angle);
+
+		// fills the wedge between two edge vertices with a fan around the center,
+		// the arc starts at center + offset and turns counter clockwise by angle radians
+		void arc(const glm::vec2& center, const glm::vec2& offset, float angle, unsigned int first, unsigned int last);
+
+		Pair startCap(const glm::vec2& p, const glm::vec2& d);
+		Pair endCap(const glm::vec2& p, const glm::vec2& d);
+
+		// edge vertices where the segment along d0 ends and the segment along d1 starts
+		void join(const glm::vec2& p, const glm::vec2& d0, const glm::vec2& d1, Pair& end, Pair& start);
+
+		// connects the start of the current segment to its end
+		void endSegment(const Pair& end);
+
+		Style m_style;
+		// the stroke covers a pixel or less on screen
+		bool m_thin;
+		bool m_closed;
+		Output m_output;
+
+		// distinct points added so far
+		int m_points;
+		glm::vec2 m_first, m_last;
+		// direction of the first and of the last segment
+		glm::vec2 m_firstDir, m_dir;
+
+		// start of the current segment
+		Pair m_previous;
+		bool m_hasPrevious;
+
+		// a closed polyline draws its first segment last, once the closing join is known
+		bool m_firstEnded;
+		glm::vec2 m_firstEnd[2];
+	};
+
+	// upper bound of the vertices and indices polyline writes for count points
+	int maxVertices(int count);
+	int maxIndices(int count);
+
+	// writes the triangles of a whole polyline
+	// @param firstVertex index of vertices[0] in the vertex buffer
+	// @param points x, y pairs
+	// @param closed joins the last point back to the first instead of capping both ends
+	// @param vertexCount, indexCount receive the number of vertices and indices written
+	void polyline(Renderer2D::Vertex* vertices, unsigned int* indices, unsigned int firstVertex,
+		const float* points, int count, bool closed, const Style& style, float depth, const float* color,
+		int& vertexCount, int& indexCount);
+}
+
+#endif // !STROKE_H_
@@ -0,0 +1,607 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: TextureLoader.cpp
+*
+* Description:	Loads textures without stalling the frame. Files are read and decoded on
+*				worker threads, the pixels are staged through a ring of pixel unpack buffers
+*				and uploaded a band of rows at a time within a byte budget per frame.
+*				KTX and KTX2 files keep their compressed blocks and mip chains when the
+*				context samples their format.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "TextureLoader.h"
+#include "GLCaps.h"
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+	/**
+	* Reads a little endian 16 bit value
+	*/
+	int readShort(const unsigned char* data) {
+		return data[0] | (data[1] << 8);
+	}
+
+	/**
+	* Converts one TGA pixel to RGBA8
+	* @param source - BGR, BGRA or a gray value
+	* @param bytes - bytes of the pixel, 1, 3 or 4
+	*/
+	void convertTgaPixel(const unsigned char* source, int bytes, unsigned char* destination) {
+		if (bytes == 1) {
+			destination[0] = destination[1] = destination[2] = source[0];
+			destination[3] = 255;
+			return;
+		}
+		destination[0] = source[2];
+		destination[1] = source[1];
+		destination[2] = source[0];
+		destination[3] = bytes == 4 ? source[3] : 255;
+	}
+
+	/**
+	* Decodes a TGA image of type 2, 3, 10 or 11 without a color map
+	* @return false if data is not such an image
+	*/
+	bool decodeTga(const unsigned char* data, size_t size, int& width, int& height, std::vector<unsigned char>& pixels) {
+		if (size < 18) {
+			return false;
+		}
+		int idLength = data[0];
+		int colorMapType = data[1];
+		int type = data[2];
+		width = readShort(data + 12);
+		height = readShort(data + 14);
+		int bits = data[16];
+		int descriptor = data[17];
+		bool gray = type == 3 || type == 11;
+		bool rle = type == 10 || type == 11;
+		if (colorMapType != 0 || (type != 2 && type != 3 && type != 10 && type != 11)) {
+			return false;
+		}
+		if (gray ? bits != 8 : (bits != 24 && bits != 32)) {
+			return false;
+		}
+		if (width == 0 || height == 0) {
+			return false;
+		}
+
+		int bytes = bits / 8;
+		size_t count = (size_t)width * height;
+		const unsigned char* source = data + 18 + idLength;
+		const unsigned char* end = data + size;
+		if (source > end) {
+			return false;
+		}
+
+		// decoded in file order first, rows are flipped below if needed
+		pixels.resize(count * 4);
+		size_t pixel = 0;
+		while (pixel < count) {
+			if (!rle) {
+				if ((size_t)(end - source) < count * bytes) {
+					return false;
+				}
+				for (; pixel < count; ++pixel, source += bytes) {
+					convertTgaPixel(source, bytes, &pixels[pixel * 4]);
+				}
+				break;
+			}
+
+			// a packet repeats one pixel or holds raw pixels, 1 to 128 of them
+			if (source >= end) {
+				return false;
+			}
+			int header = *source++;
+			size_t run = std::min((size_t)(header & 0x7f) + 1, count - pixel);
+			if (header & 0x80) {
+				if (end - source < bytes) {
+					return false;
+				}
+				for (size_t i = 0; i < run; ++i) {
+					convertTgaPixel(source, bytes, &pixels[(pixel + i) * 4]);
+				}
+				source += bytes;
+			}
+			else {
+				if ((size_t)(end - source) < run * bytes) {
+					return false;
+				}
+				for (size_t i = 0; i < run; ++i, source += bytes) {
+					convertTgaPixel(source, bytes, &pixels[(pixel + i) * 4]);
+				}
+			}
+			pixel += run;
+		}
+
+		// bit 4 stores the columns right to left, bit 5 the rows top to bottom
+		size_t rowBytes = (size_t)width * 4;
+		if (descriptor & 0x10) {
+			for (int y = 0; y < height; ++y) {
+				unsigned int* row = (unsigned int*)&pixels[y * rowBytes];
+				std::reverse(row, row + width);
+			}
+		}
+		if (descriptor & 0x20) {
+			for (int y = 0; y < height / 2; ++y) {
+				std::swap_ranges(pixels.begin() + y * rowBytes, pixels.begin() + (y + 1) * rowBytes,
+					pixels.begin() + (height - 1 - y) * rowBytes);
+			}
+		}
+		return true;
+	}
+
+	/**
+	* Reads the next number of a PPM header, skipping whitespace and comments
+	* @return -1 if there is none
+	*/
+	int readPpmNumber(const unsigned char*& source, const unsigned char* end) {
+		while (source < end) {
+			if (*source == '#') {
+				while (source < end && *source != '\n') {
+					++source;
+				}
+			}
+			else if (*source == ' ' || *source == '\t' || *source == '\r' || *source == '\n') {
+				++source;
+			}
+			else {
+				break;
+			}
+		}
+		if (source == end || *source < '0' || *source > '9') {
+			return -1;
+		}
+		int value = 0;
+		while (source < end && *source >= '0' && *source <= '9' && value < 1 << 20) {
+			value = value * 10 + (*source++ - '0');
+		}
+		return value;
+	}
+
+	/**
+	* Decodes a binary PPM with 8 bit samples
+	* @return false if data is not such an image
+	*/
+	bool decodePpm(const unsigned char* data, size_t size, int& width, int& height, std::vector<unsigned char>& pixels) {
+		if (size < 2 || data[0] != 'P' || data[1] != '6') {
+			return false;
+		}
+		const unsigned char* source = data + 2;
+		const unsigned char* end = data + size;
+		width = readPpmNumber(source, end);
+		height = readPpmNumber(source, end);
+		int maxValue = readPpmNumber(source, end);
+		if (width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 255) {
+			return false;
+		}
+		// a single whitespace character separates the header from the samples
+		++source;
+		if (source > end || (size_t)(end - source) < (size_t)width * height * 3) {
+			return false;
+		}
+
+		// PPM stores the top row first
+		pixels.resize((size_t)width * height * 4);
+		for (int y = 0; y < height; ++y) {
+			unsigned char* row = &pixels[(size_t)(height - 1 - y) * width * 4];
+			for (int x = 0; x < width; ++x, source += 3, row += 4) {
+				row[0] = (unsigned char)(source[0] * 255 / maxValue);
+				row[1] = (unsigned char)(source[1] * 255 / maxValue);
+				row[2] = (unsigned char)(source[2] * 255 / maxValue);
+				row[3] = 255;
+			}
+		}
+		return true;
+	}
+}
+
+TextureLoader::TextureLoader(const GLCaps* caps) : m_caps(caps) {
+	// magenta and black, so a texture that never arrives stands out
+	const unsigned char checker[] = {
+		255, 0, 255, 255,	0, 0, 0, 255,
+		0, 0, 0, 255,		255, 0, 255, 255
+	};
+	glGenTextures(1, &m_placeholder);
+	glBindTexture(GL_TEXTURE_2D, m_placeholder);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, checker);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	GLDebug::label(GL_TEXTURE, m_placeholder, "TextureLoader placeholder");
+
+	glGenBuffers(RING_SIZE, m_buffers);
+	for (int i = 0; i < RING_SIZE; ++i) {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[i]);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, RING_BUFFER_BYTES, nullptr, GL_STREAM_DRAW);
+		GLDebug::label(GL_BUFFER, m_buffers[i], "TextureLoader staging");
+		m_fences[i] = nullptr;
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	m_nextBuffer = 0;
+
+	m_budget = DEFAULT_BUDGET;
+	m_uploading = nullptr;
+	m_uploadLevel = 0;
+	m_uploadedRows = 0;
+	m_stop = false;
+}
+
+TextureHandle TextureLoader::load(const char* path, const Renderer2D::ImageDecoder& decoder) {
+	Texture texture;
+	texture.texture = 0;
+	texture.state = Renderer2D::TEXTURE_LOADING;
+	texture.width = 0;
+	texture.height = 0;
+	texture.bytes = 0;
+	texture.alive = true;
+	m_textures.push_back(texture);
+	TextureHandle handle = (TextureHandle)m_textures.size();
+
+	if (m_workers.empty()) {
+		startWorkers();
+	}
+	Job job;
+	job.handle = handle;
+	job.path = path;
+	job.decoder = decoder;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(job);
+	}
+	m_wake.notify_one();
+	return handle;
+}
+
+unsigned int TextureLoader::getTexture(TextureHandle texture) const {
+	if (texture == 0 || texture > m_textures.size() || !m_textures[texture - 1].alive) {
+		return m_placeholder;
+	}
+	const Texture& entry = m_textures[texture - 1];
+	return entry.state == Renderer2D::TEXTURE_RESIDENT ? entry.texture : m_placeholder;
+}
+
+Renderer2D::TextureState TextureLoader::getState(TextureHandle texture) const {
+	if (texture == 0 || texture > m_textures.size() || !m_textures[texture - 1].alive) {
+		return Renderer2D::TEXTURE_FAILED;
+	}
+	return m_textures[texture - 1].state;
+}
+
+bool TextureLoader::getSize(TextureHandle texture, int& width, int& height) const {
+	if (texture == 0 || texture > m_textures.size() || !m_textures[texture - 1].alive || m_textures[texture - 1].width == 0) {
+		return false;
+	}
+	width = m_textures[texture - 1].width;
+	height = m_textures[texture - 1].height;
+	return true;
+}
+
+size_t TextureLoader::getMemory() const {
+	size_t bytes = 0;
+	for (size_t i = 0; i < m_textures.size(); ++i) {
+		if (m_textures[i].state == Renderer2D::TEXTURE_RESIDENT) {
+			bytes += m_textures[i].bytes;
+		}
+	}
+	return bytes;
+}
+
+void TextureLoader::destroy(TextureHandle texture) {
+	if (texture == 0 || texture > m_textures.size() || !m_textures[texture - 1].alive) {
+		return;
+	}
+	Texture& entry = m_textures[texture - 1];
+	glDeleteTextures(1, &entry.texture);
+	entry.texture = 0;
+	entry.alive = false;
+	// a destroyed texture is no longer resident, so it is not counted by getMemory either
+	entry.state = Renderer2D::TEXTURE_FAILED;
+	if (m_uploading && m_uploading->handle == texture) {
+		delete m_uploading;
+		m_uploading = nullptr;
+	}
+}
+
+void TextureLoader::setBudget(size_t bytes) {
+	m_budget = bytes;
+}
+
+void TextureLoader::update() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_ready.insert(m_ready.end(), m_decoded.begin(), m_decoded.end());
+		m_decoded.clear();
+	}
+
+	size_t budget = m_budget;
+	bool first = true;
+	while (m_uploading || !m_ready.empty()) {
+		if (!m_uploading) {
+			Decoded* decoded = m_ready.front();
+			m_ready.pop_front();
+			Texture& entry = m_textures[decoded->handle - 1];
+			if (!entry.alive) {
+				delete decoded;
+				continue;
+			}
+			if (decoded->error) {
+				std::cout << "ERROR::TEXTURE::" << decoded->error << " " << decoded->path << std::endl;
+				entry.state = Renderer2D::TEXTURE_FAILED;
+				delete decoded;
+				continue;
+			}
+			allocate(entry, decoded);
+			m_uploading = decoded;
+			m_uploadLevel = 0;
+			m_uploadedRows = 0;
+		}
+
+		// a band is the rows of blocks that fit in one staging buffer and in the budget left,
+		// the first band of the frame goes even if it is over the budget
+		const CompressedImage& image = m_uploading->image;
+		const CompressedImage::Level& level = image.levels[m_uploadLevel];
+		int block = CompressedImage::blockSize(image.format);
+		int blockRows = (level.height + block - 1) / block;
+		size_t rowBytes = level.size / blockRows;
+		size_t budgetRows = budget / rowBytes;
+		if (budgetRows == 0 && !first) {
+			break;
+		}
+		int rows = (int)std::min((size_t)(blockRows - m_uploadedRows),
+			std::min(RING_BUFFER_BYTES / rowBytes, std::max(budgetRows, (size_t)1)));
+		if (!acquireBuffer()) {
+			break;
+		}
+
+		// the fence says the GPU is done with the buffer, so the mapping does not need to wait
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[m_nextBuffer]);
+		void* staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, rows * rowBytes,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (!staging) {
+			break;
+		}
+		memcpy(staging, &m_uploading->pixels[level.offset + m_uploadedRows * rowBytes], rows * rowBytes);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		glBindTexture(GL_TEXTURE_2D, m_textures[m_uploading->handle - 1].texture);
+		int y = m_uploadedRows * block;
+		int height = std::min(rows * block, level.height - y);
+		if (image.format == CompressedImage::FORMAT_RGBA8) {
+			glTexSubImage2D(GL_TEXTURE_2D, m_uploadLevel, 0, y, level.width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		}
+		else {
+			glCompressedTexSubImage2D(GL_TEXTURE_2D, m_uploadLevel, 0, y, level.width, height,
+				CompressedImage::glFormat(image.format), (GLsizei)(rows * rowBytes), nullptr);
+		}
+		m_fences[m_nextBuffer] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_nextBuffer = (m_nextBuffer + 1) % RING_SIZE;
+
+		budget -= std::min(budget, rows * rowBytes);
+		first = false;
+		m_uploadedRows += rows;
+		if (m_uploadedRows < blockRows) {
+			continue;
+		}
+		m_uploadedRows = 0;
+		if (++m_uploadLevel < (int)image.levels.size()) {
+			continue;
+		}
+
+		// an image without a mip chain gets one, unless its blocks would have to be compressed again
+		if (image.levels.size() == 1 && image.format == CompressedImage::FORMAT_RGBA8) {
+			glGenerateMipmap(GL_TEXTURE_2D);
+		}
+		m_textures[m_uploading->handle - 1].state = Renderer2D::TEXTURE_RESIDENT;
+		delete m_uploading;
+		m_uploading = nullptr;
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool TextureLoader::decodeBuiltin(void* user, const unsigned char* data, size_t size,
+	int& width, int& height, std::vector<unsigned char>& pixels) {
+	(void)user;
+	return decodePpm(data, size, width, height, pixels) || decodeTga(data, size, width, height, pixels);
+}
+
+void TextureLoader::work() {
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+			if (m_stop) {
+				return;
+			}
+			job = m_jobs.front();
+			m_jobs.pop_front();
+		}
+
+		Decoded* decoded = new Decoded();
+		decoded->handle = job.handle;
+		decoded->path = job.path;
+		decode(job, decoded);
+		if (decoded->error) {
+			decoded->pixels.clear();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_decoded.push_back(decoded);
+	}
+}
+
+void TextureLoader::decode(const Job& job, Decoded* decoded) const {
+	std::ifstream file(job.path.c_str(), std::ios::binary);
+	std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	CompressedImage& image = decoded->image;
+	decoded->error = "LOAD_FAILED";
+
+	if (CompressedImage::isKtx(data.data(), data.size())) {
+		if (!CompressedImage::parse(data.data(), data.size(), image)) {
+			decoded->error = "UNSUPPORTED_FORMAT";
+			return;
+		}
+		if (CompressedImage::isSupported(image.format, *m_caps)) {
+			// the bottom row goes first like the decoded images, unless a level cannot be flipped,
+			// then every level keeps the order of the file so the mip chain stays consistent
+			bool flip = image.topFirst;
+			for (size_t i = 0; i < image.levels.size() && flip; ++i) {
+				flip = CompressedImage::canFlip(image.format, image.levels[i].height);
+			}
+			for (size_t i = 0; i < image.levels.size() && flip; ++i) {
+				const CompressedImage::Level& level = image.levels[i];
+				CompressedImage::flip(image.format, &data[level.offset], level.width, level.height);
+			}
+			decoded->pixels.swap(data);
+		}
+		else {
+			// the context cannot sample the blocks, every level is decoded to RGBA8
+			if (!CompressedImage::canDecode(image.format)) {
+				decoded->error = "UNSUPPORTED_FORMAT";
+				return;
+			}
+			size_t offset = 0;
+			for (size_t i = 0; i < image.levels.size(); ++i) {
+				CompressedImage::Level& level = image.levels[i];
+				size_t size = CompressedImage::levelSize(CompressedImage::FORMAT_RGBA8, level.width, level.height);
+				decoded->pixels.resize(offset + size);
+				CompressedImage::decode(image.format, &data[level.offset], level.width, level.height, &decoded->pixels[offset]);
+				if (image.topFirst) {
+					CompressedImage::flip(CompressedImage::FORMAT_RGBA8, &decoded->pixels[offset], level.width, level.height);
+				}
+				level.offset = offset;
+				level.size = size;
+				offset += size;
+			}
+			image.format = CompressedImage::FORMAT_RGBA8;
+		}
+	}
+	else {
+		int width = 0;
+		int height = 0;
+		if (data.empty() || !job.decoder.decode(job.decoder.user, data.data(), data.size(), width, height, decoded->pixels) ||
+			width <= 0 || height <= 0 || decoded->pixels.size() != (size_t)width * height * 4) {
+			return;
+		}
+		image.format = CompressedImage::FORMAT_RGBA8;
+		image.width = width;
+		image.height = height;
+		CompressedImage::Level level;
+		level.width = width;
+		level.height = height;
+		level.offset = 0;
+		level.size = decoded->pixels.size();
+		image.levels.assign(1, level);
+	}
+
+	// a row of blocks has to fit in one staging buffer
+	int block = CompressedImage::blockSize(image.format);
+	if (image.levels[0].size / ((image.height + block - 1) / block) > RING_BUFFER_BYTES) {
+		decoded->error = "ROW_TOO_LARGE";
+		return;
+	}
+	decoded->error = nullptr;
+}
+
+void TextureLoader::allocate(Texture& texture, const Decoded* decoded) {
+	const CompressedImage& image = decoded->image;
+	texture.width = image.width;
+	texture.height = image.height;
+	texture.bytes = 0;
+	glGenTextures(1, &texture.texture);
+	glBindTexture(GL_TEXTURE_2D, texture.texture);
+	GLDebug::label(GL_TEXTURE, texture.texture, decoded->path.c_str());
+
+	// storage is allocated without a pixel unpack buffer bound, the data comes in bands later
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	for (size_t i = 0; i < image.levels.size(); ++i) {
+		const CompressedImage::Level& level = image.levels[i];
+		if (image.format == CompressedImage::FORMAT_RGBA8) {
+			glTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		}
+		else {
+			glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, CompressedImage::glFormat(image.format),
+				level.width, level.height, 0, (GLsizei)level.size, nullptr);
+		}
+		texture.bytes += level.size;
+	}
+
+	// a chain from the file ends where the file ends it, a generated one adds a third
+	if (image.levels.size() > 1 || image.format != CompressedImage::FORMAT_RGBA8) {
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)image.levels.size() - 1);
+	}
+	else {
+		texture.bytes += texture.bytes / 3;
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void TextureLoader::startWorkers() {
+	// one core is left to the thread drawing the frames
+	int count = (int)std::thread::hardware_concurrency() - 1;
+	count = std::max(1, std::min(count, (int)MAX_WORKERS));
+	for (int i = 0; i < count; ++i) {
+		m_workers.push_back(std::thread(&TextureLoader::work, this));
+	}
+}
+
+bool TextureLoader::acquireBuffer() {
+	GLsync fence = (GLsync)m_fences[m_nextBuffer];
+	if (!fence) {
+		return true;
+	}
+	if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+		return false;
+	}
+	glDeleteSync(fence);
+	m_fences[m_nextBuffer] = nullptr;
+	return true;
+}
+
+TextureLoader::~TextureLoader() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for (size_t i = 0; i < m_workers.size(); ++i) {
+		m_workers[i].join();
+	}
+	for (size_t i = 0; i < m_decoded.size(); ++i) {
+		delete m_decoded[i];
+	}
+	for (size_t i = 0; i < m_ready.size(); ++i) {
+		delete m_ready[i];
+	}
+	delete m_uploading;
+
+	for (int i = 0; i < RING_SIZE; ++i) {
+		if (m_fences[i]) {
+			glDeleteSync((GLsync)m_fences[i]);
+		}
+	}
+	glDeleteBuffers(RING_SIZE, m_buffers);
+	for (size_t i = 0; i < m_textures.size(); ++i) {
+		if (m_textures[i].texture) {
+			glDeleteTextures(1, &m_textures[i].texture);
+		}
+	}
+	glDeleteTextures(1, &m_placeholder);
+}
@@ -0,0 +1,151 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: TextureLoader.h
+*
+* Description:	Loads textures without stalling the frame. Files are read and decoded on
+*				worker threads, the pixels are staged through a ring of pixel unpack buffers
+*				and uploaded a band of rows at a time within a byte budget per frame.
+*				KTX and KTX2 files keep their compressed blocks and mip chains when the
+*				context samples their format. Until a texture is resident it samples
+*				as a placeholder.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef TEXTURELOADER_H_
+#define TEXTURELOADER_H_
+
+#include "CompressedImage.h"
+#include "Renderer2D.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TextureLoader {
+public:
+	enum {
+		// pixel unpack buffers the uploads rotate through, each guarded by a fence,
+		// so the copy into one never waits for the GPU to finish reading another
+		RING_SIZE = 4,
+		RING_BUFFER_BYTES = 1 << 20,
+		// bytes uploaded per frame unless setBudget says otherwise
+		DEFAULT_BUDGET = 4 << 20,
+		MAX_WORKERS = 4
+	};
+
+	// @param caps - compressed formats the context samples, the others are decoded on the workers
+	explicit TextureLoader(const GLCaps* caps);
+
+	// queues a file for the workers, they start with the first load,
+	// KTX and KTX2 files are read by the loader, other files by decoder
+	TextureHandle load(const char* path, const Renderer2D::ImageDecoder& decoder);
+
+	// the texture to sample, the placeholder until the texture is resident
+	unsigned int getTexture(TextureHandle texture) const;
+	Renderer2D::TextureState getState(TextureHandle texture) const;
+
+	// size of a texture once it is decoded
+	// @return false while it is still being decoded, if it failed or if it was destroyed
+	bool getSize(TextureHandle texture, int& width, int& height) const;
+
+	// bytes of GPU memory the resident textures take, mipmaps included
+	size_t getMemory() const;
+
+	// deletes a texture, a decode still running for it is thrown away when it arrives
+	void destroy(TextureHandle texture);
+
+	// bytes staged and uploaded per frame, one band of rows is uploaded each frame
+	// even if it is larger, so a small budget slows the uploads down but never stops them
+	void setBudget(size_t bytes);
+
+	// uploads decoded pixels within the budget, called once per frame on the GL thread
+	void update();
+
+	// decodes uncompressed and run length encoded TGA and binary PPM
+	static bool decodeBuiltin(void* user, const unsigned char* data, size_t size,
+		int& width, int& height, std::vector<unsigned char>& pixels);
+
+	~TextureLoader();
+
+protected:
+	struct Job {
+		TextureHandle handle;
+		std::string path;
+		Renderer2D::ImageDecoder decoder;
+	};
+
+	// result of a worker, the levels of image are in pixels with the bottom row first,
+	// except levels of top first files that CompressedImage::canFlip rejects, those keep the order of the file
+	struct Decoded {
+		TextureHandle handle;
+		std::string path;
+		// what went wrong, nullptr if the texture can be uploaded
+		const char* error;
+		CompressedImage image;
+		std::vector<unsigned char> pixels;
+	};
+
+	struct Texture {
+		unsigned int texture;
+		Renderer2D::TextureState state;
+		int width, height;
+		size_t bytes;
+		// false once destroyed, handles are not reused
+		bool alive;
+	};
+
+	// runs on the worker threads until m_stop is set
+	void work();
+
+	// reads and decodes the file of job into decoded, on a worker thread
+	void decode(const Job& job, Decoded* decoded) const;
+
+	// creates the texture and the storage of its levels when its upload starts
+	void allocate(Texture& texture, const Decoded* decoded);
+
+	// starts the workers
+	void startWorkers();
+
+	// takes the next buffer of the ring if the GPU is done with it
+	// @return false if it is still in use, the upload waits for the next frame
+	bool acquireBuffer();
+
+	const GLCaps* m_caps;
+
+	std::vector<Texture> m_textures;
+
+	// 2x2 checkerboard sampled in place of textures that are not resident
+	unsigned int m_placeholder;
+
+	unsigned int m_buffers[RING_SIZE];
+	void* m_fences[RING_SIZE];
+	int m_nextBuffer;
+
+	size_t m_budget;
+
+	// decoded images waiting for upload and the one being uploaded, with the level
+	// being uploaded and its rows of blocks done so far
+	std::deque<Decoded*> m_ready;
+	Decoded* m_uploading;
+	int m_uploadLevel;
+	int m_uploadedRows;
+
+	// shared with the workers, guarded by m_mutex
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<Job> m_jobs;
+	std::deque<Decoded*> m_decoded;
+	bool m_stop;
+};
+
+#endif // !TEXTURELOADER_H_
@@ -0,0 +1,252 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Triangulate.cpp
+*
+* Description:	Triangulates concave polygons with holes by ear clipping.
+*				Holes are bridged into the outline first, so one pass clips the whole shape.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Triangulate.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace {
+	inline glm::vec2 point(const float* points, unsigned int i) {
+		return glm::vec2(points[i * 2 + 0], points[i * 2 + 1]);
+	}
+
+	// twice the signed area of the triangle, positive when counter clockwise
+	inline float cross(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) {
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	}
+
+	// true if p lies inside or on the edges of the counter clockwise triangle abc
+	inline bool inTriangle(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) {
+		return cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f;
+	}
+
+	// true if p lies in the interior angle of the counter clockwise outline at v,
+	// between the edges from before to v and from v to after
+	inline bool inWedge(const glm::vec2& p, const glm::vec2& before, const glm::vec2& v, const glm::vec2& after) {
+		if (cross(before, v, after) >= 0.0f) {
+			return cross(before, v, p) > 0.0f && cross(v, after, p) > 0.0f;
+		}
+		return cross(before, v, p) > 0.0f || cross(v, after, p) > 0.0f;
+	}
+
+	// appends the point indices of a ring in the requested winding
+	void addRing(std::vector<unsigned int>& ring, const float* points, int first, int count, bool counterClockwise) {
+		float area = 0.0f;
+		for (int i = 0; i < count; ++i) {
+			glm::vec2 a = point(points, first + i);
+			glm::vec2 b = point(points, first + (i + 1) % count);
+			area += a.x * b.y - b.x * a.y;
+		}
+		bool reverse = (area > 0.0f) != counterClockwise;
+		for (int i = 0; i < count; ++i) {
+			ring.push_back((unsigned int)(reverse ? first + count - 1 - i : first + i));
+		}
+	}
+
+	// joins a clockwise hole into the counter clockwise outline with a bridge
+	// from the rightmost hole point to an outline point it can see
+	void bridge(std::vector<unsigned int>& outline, const std::vector<unsigned int>& hole, const float* points) {
+		size_t right = 0;
+		for (size_t i = 1; i < hole.size(); ++i) {
+			if (point(points, hole[i]).x > point(points, hole[right]).x) {
+				right = i;
+			}
+		}
+		glm::vec2 m = point(points, hole[right]);
+
+		// closest outline edge hit by a ray from m towards +x
+		size_t count = outline.size();
+		size_t edge = count;
+		float hitX = std::numeric_limits<float>::max();
+		for (size_t i = 0; i < count; ++i) {
+			glm::vec2 a = point(points, outline[i]);
+			glm::vec2 b = point(points, outline[(i + 1) % count]);
+			if ((a.y > m.y) == (b.y > m.y)) {
+				continue;
+			}
+			float x = a.x + (m.y - a.y) * (b.x - a.x) / (b.y - a.y);
+			if (x >= m.x && x < hitX) {
+				hitX = x;
+				edge = i;
+			}
+		}
+		// the hole is not inside the outline
+		if (edge == count) {
+			return;
+		}
+
+		// the edge end furthest along the ray is a candidate, unless a reflex outline
+		// point inside the triangle m, hit, candidate blocks it, then the blocking
+		// point closest in angle to the ray is visible instead
+		size_t visible = (point(points, outline[edge]).x > point(points, outline[(edge + 1) % count]).x ? edge : (edge + 1) % count);
+		glm::vec2 hit(hitX, m.y);
+		glm::vec2 p = point(points, outline[visible]);
+		if (p != hit) {
+			glm::vec2 a = m, b = hit, c = p;
+			if (cross(a, b, c) < 0.0f) {
+				std::swap(b, c);
+			}
+			float bestTangent = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < count; ++i) {
+				glm::vec2 r = point(points, outline[i]);
+				glm::vec2 before = point(points, outline[(i + count - 1) % count]);
+				glm::vec2 after = point(points, outline[(i + 1) % count]);
+				if (i == visible || r.x <= m.x || cross(before, r, after) >= 0.0f || !inTriangle(r, a, b, c)) {
+					continue;
+				}
+				float tangent = glm::abs(r.y - m.y) / (r.x - m.x);
+				if (tangent < bestTangent || (tangent == bestTangent && r.x < point(points, outline[visible]).x)) {
+					bestTangent = tangent;
+					visible = i;
+				}
+			}
+		}
+
+		// earlier bridges leave copies of their end points in the outline, only the copy
+		// whose interior angle contains m can take the bridge without crossing the outline
+		glm::vec2 v = point(points, outline[visible]);
+		for (size_t i = 0; i < count; ++i) {
+			if (point(points, outline[i]) == v &&
+				inWedge(m, point(points, outline[(i + count - 1) % count]), v, point(points, outline[(i + 1) % count]))) {
+				visible = i;
+				break;
+			}
+		}
+
+		// outline up to the visible point, around the hole and back over the bridge
+		std::vector<unsigned int> merged;
+		merged.reserve(count + hole.size() + 2);
+		merged.insert(merged.end(), outline.begin(), outline.begin() + visible + 1);
+		for (size_t i = 0; i <= hole.size(); ++i) {
+			merged.push_back(hole[(right + i) % hole.size()]);
+		}
+		merged.push_back(outline[visible]);
+		merged.insert(merged.end(), outline.begin() + visible + 1, outline.end());
+		outline.swap(merged);
+	}
+}
+
+bool Triangulate::earClip(const float* points, const int* ringSizes, int ringCount, std::vector<unsigned int>& indices) {
+	indices.clear();
+	if (ringCount < 1 || ringSizes[0] < 3) {
+		return true;
+	}
+
+	std::vector<unsigned int> outline;
+	addRing(outline, points, 0, ringSizes[0], true);
+
+	// holes are bridged rightmost first, so later bridges cannot cross earlier ones
+	struct Hole {
+		int first;
+		int count;
+		float right;
+	};
+	std::vector<Hole> holes;
+	int first = ringSizes[0];
+	for (int i = 1; i < ringCount; ++i) {
+		if (ringSizes[i] >= 3) {
+			Hole hole = { first, ringSizes[i], point(points, first).x };
+			for (int j = 1; j < ringSizes[i]; ++j) {
+				hole.right = glm::max(hole.right, point(points, first + j).x);
+			}
+			holes.push_back(hole);
+		}
+		first += ringSizes[i];
+	}
+	std::sort(holes.begin(), holes.end(), [](const Hole& a, const Hole& b) { return a.right > b.right; });
+
+	std::vector<unsigned int> ring;
+	for (size_t i = 0; i < holes.size(); ++i) {
+		ring.clear();
+		addRing(ring, points, holes[i].first, holes[i].count, false);
+		bridge(outline, ring, points);
+	}
+
+	// clip ears off a circular list until one triangle is left
+	int count = (int)outline.size();
+	std::vector<int> prev(count), next(count);
+	for (int i = 0; i < count; ++i) {
+		prev[i] = (i + count - 1) % count;
+		next[i] = (i + 1) % count;
+	}
+	indices.reserve((count - 2) * 3);
+
+	int remaining = count;
+	int current = 0;
+	int stalled = 0;
+	while (remaining > 3) {
+		int before = prev[current];
+		int after = next[current];
+		glm::vec2 a = point(points, outline[before]);
+		glm::vec2 b = point(points, outline[current]);
+		glm::vec2 c = point(points, outline[after]);
+		float area = cross(a, b, c);
+
+		// a convex corner is an ear when no other reflex point lies inside it,
+		// bridge duplicates of the corner points are ignored
+		bool ear = area > 0.0f;
+		for (int i = next[after]; ear && i != before; i = next[i]) {
+			glm::vec2 q = point(points, outline[i]);
+			if (q == a || q == b || q == c) {
+				continue;
+			}
+			if (cross(point(points, outline[prev[i]]), q, point(points, outline[next[i]])) < 0.0f && inTriangle(q, a, b, c)) {
+				ear = false;
+			}
+		}
+
+		// collinear corners and spikes are dropped without a triangle
+		if (ear || area == 0.0f) {
+			if (ear) {
+				indices.push_back(outline[before]);
+				indices.push_back(outline[after]);
+				indices.push_back(outline[current]);
+			}
+			next[before] = after;
+			prev[after] = before;
+			remaining--;
+			stalled = 0;
+		}
+		else if (++stalled >= remaining) {
+			// no ear left, the polygon intersects itself
+			return false;
+		}
+		current = after;
+	}
+
+	int before = prev[current];
+	int after = next[current];
+	if (cross(point(points, outline[before]), point(points, outline[current]), point(points, outline[after])) > 0.0f) {
+		indices.push_back(outline[before]);
+		indices.push_back(outline[after]);
+		indices.push_back(outline[current]);
+	}
+	return true;
+}
+
+unsigned long long Triangulate::hash(const float* points, int count, const int* ringSizes, int ringCount) {
+	unsigned long long h = 14695981039346656037ull;
+	const unsigned char* bytes = (const unsigned char*)points;
+	for (size_t i = 0; i < sizeof(float) * 2 * (size_t)count; ++i) {
+		h = (h ^ bytes[i]) * 1099511628211ull;
+	}
+	bytes = (const unsigned char*)ringSizes;
+	for (size_t i = 0; i < sizeof(int) * (size_t)ringCount; ++i) {
+		h = (h ^ bytes[i]) * 1099511628211ull;
+	}
+	return h;
+}
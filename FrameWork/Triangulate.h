@@ -0,0 +1,34 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Triangulate.h
+*
+* Description:	Triangulates concave polygons with holes by ear clipping.
+*				Holes are bridged into the outline first, so one pass clips the whole shape.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef TRIANGULATE_H_
+#define TRIANGULATE_H_
+
+#include <vector>
+
+namespace Triangulate {
+	// triangulates a polygon, the winding of the rings does not matter
+	// @param points x, y pairs of all rings one after another
+	// @param ringSizes points per ring, the first ring is the outline and the others are holes inside it
+	// @param indices receives 3 indices into points per triangle, wound clockwise
+	// @return false if the polygon intersects itself and was only partly triangulated
+	bool earClip(const float* points, const int* ringSizes, int ringCount, std::vector<unsigned int>& indices);
+
+	// 64-bit FNV-1a hash of the points and ring sizes, used to cache triangulations
+	unsigned long long hash(const float* points, int count, const int* ringSizes, int ringCount);
+}
+
+#endif // !TRIANGULATE_H_
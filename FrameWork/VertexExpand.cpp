@@ -0,0 +1,323 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: VertexExpand.cpp
+*
+* Description:	Expands arrays of shapes into vertices and indices.
+*				Uses the SSE wrappers of glm/simd where the target supports them.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "VertexExpand.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/simd/common.h>
+#include <limits>
+
+static_assert(sizeof(Renderer2D::Vertex) == 7 * sizeof(float), "the kernels write vertices as 7 packed floats");
+
+namespace {
+	// unit circle outline shared by all circles
+	struct CircleTable {
+		float sin[VertexExpand::CIRCLE_SEGMENTS];
+		float cos[VertexExpand::CIRCLE_SEGMENTS];
+		unsigned int indices[VertexExpand::CIRCLE_INDICES];
+
+		CircleTable() {
+			float rotDelta = glm::pi<float>() * 2 / VertexExpand::CIRCLE_SEGMENTS;
+			for (int i = 0; i < VertexExpand::CIRCLE_SEGMENTS; ++i) {
+				sin[i] = glm::sin(rotDelta * i);
+				cos[i] = glm::cos(rotDelta * i);
+			}
+			// a fan around the center vertex, closed back to the first outline vertex
+			for (int i = 0; i < VertexExpand::CIRCLE_SEGMENTS; ++i) {
+				indices[i * 3 + 0] = 0;
+				indices[i * 3 + 1] = (i == VertexExpand::CIRCLE_SEGMENTS - 1) ? 1 : i + 2;
+				indices[i * 3 + 2] = (i == VertexExpand::CIRCLE_SEGMENTS - 1) ? VertexExpand::CIRCLE_SEGMENTS : i + 1;
+			}
+		}
+	};
+
+	const CircleTable& circleTable() {
+		static const CircleTable table;
+		return table;
+	}
+
+	void storeVertex(Renderer2D::Vertex& v, float x, float y, float depth, const float* color) {
+		v.pos[0] = x;
+		v.pos[1] = y;
+		v.pos[2] = depth;
+		v.color[0] = color[0];
+		v.color[1] = color[1];
+		v.color[2] = color[2];
+		v.color[3] = color[3];
+	}
+
+	// true if the box overlaps the bounds, both as min x, min y, max x, max y, no bounds overlap everything
+	inline bool overlaps(const float* bounds, float minX, float minY, float maxX, float maxY) {
+		return bounds == nullptr || (maxX >= bounds[0] && maxY >= bounds[1] && minX <= bounds[2] && minY <= bounds[3]);
+	}
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// splits the cull bounds into the vectors overlaps compares a (min x, min y, max x, max y) box with
+	inline void cullBounds(const float* bounds, glm_vec4& viewMin, glm_vec4& viewMax) {
+		float infinity = std::numeric_limits<float>::infinity();
+		if (bounds == nullptr) {
+			viewMin = _mm_set1_ps(-infinity);
+			viewMax = _mm_set1_ps(infinity);
+			return;
+		}
+		// the box max has to reach the view min and the box min must not pass the view max
+		viewMin = _mm_setr_ps(-infinity, -infinity, bounds[0], bounds[1]);
+		viewMax = _mm_setr_ps(bounds[2], bounds[3], infinity, infinity);
+	}
+
+	inline bool overlaps(glm_vec4 box, glm_vec4 viewMin, glm_vec4 viewMax) {
+		glm_vec4 inside = _mm_and_ps(_mm_cmpge_ps(box, viewMin), _mm_cmple_ps(box, viewMax));
+		return _mm_movemask_ps(inside) == 0xF;
+	}
+
+	// (z, r, g, b), the vector every run of 4 vertices shares
+	inline glm_vec4 depthColor(glm_vec4 depth, glm_vec4 color) {
+		return _mm_move_ss(_mm_shuffle_ps(color, color, _MM_SHUFFLE(2, 1, 0, 3)), depth);
+	}
+
+	// writes 4 vertices of the same color and depth, 28 floats, with 7 unaligned stores
+	// @param xs, ys positions of the 4 vertices
+	// @param zrgb result of depthColor
+	inline void storeQuad(float* out, glm_vec4 xs, glm_vec4 ys, glm_vec4 zrgb, glm_vec4 color) {
+		glm_vec4 xy01 = _mm_unpacklo_ps(xs, ys);
+		glm_vec4 xy23 = _mm_unpackhi_ps(xs, ys);
+
+		// x0 y0 z r
+		_mm_storeu_ps(out + 0, _mm_shuffle_ps(xy01, zrgb, _MM_SHUFFLE(1, 0, 1, 0)));
+		// g b a x1
+		glm_vec4 ax1 = _mm_shuffle_ps(color, xy01, _MM_SHUFFLE(2, 2, 3, 3));
+		_mm_storeu_ps(out + 4, _mm_shuffle_ps(color, ax1, _MM_SHUFFLE(2, 0, 2, 1)));
+		// y1 z r g
+		glm_vec4 y1z = _mm_shuffle_ps(xy01, zrgb, _MM_SHUFFLE(0, 0, 3, 3));
+		_mm_storeu_ps(out + 8, _mm_shuffle_ps(y1z, zrgb, _MM_SHUFFLE(2, 1, 2, 0)));
+		// b a x2 y2
+		_mm_storeu_ps(out + 12, _mm_shuffle_ps(color, xy23, _MM_SHUFFLE(1, 0, 3, 2)));
+		// z r g b
+		_mm_storeu_ps(out + 16, zrgb);
+		// a x3 y3 z
+		glm_vec4 ax3 = _mm_shuffle_ps(color, xy23, _MM_SHUFFLE(2, 2, 3, 3));
+		glm_vec4 y3z = _mm_shuffle_ps(xy23, zrgb, _MM_SHUFFLE(0, 0, 3, 3));
+		_mm_storeu_ps(out + 20, _mm_shuffle_ps(ax3, y3z, _MM_SHUFFLE(2, 0, 2, 0)));
+		// r g b a
+		_mm_storeu_ps(out + 24, color);
+	}
+
+	// writes the 4 corners of a rectangle given as (left, bottom, right, top)
+	inline void storeRect(float* out, glm_vec4 bounds, glm_vec4 zrgb, glm_vec4 color) {
+		glm_vec4 xs = _mm_shuffle_ps(bounds, bounds, _MM_SHUFFLE(0, 2, 2, 0));
+		glm_vec4 ys = _mm_shuffle_ps(bounds, bounds, _MM_SHUFFLE(1, 1, 3, 3));
+		storeQuad(out, xs, ys, zrgb, color);
+	}
+
+	// writes the center and outline of a circle
+	inline void storeCircle(float* out, float x, float y, float radius, glm_vec4 depth, glm_vec4 color) {
+		const CircleTable& table = circleTable();
+		glm_vec4 zrgb = depthColor(depth, color);
+
+		// center: x y z r g b a
+		_mm_storeu_ps(out, _mm_shuffle_ps(_mm_unpacklo_ps(_mm_set_ss(x), _mm_set_ss(y)), zrgb, _MM_SHUFFLE(1, 0, 1, 0)));
+		_mm_storeu_ps(out + 3, color);
+		out += 7;
+
+		glm_vec4 cx = _mm_set1_ps(x);
+		glm_vec4 cy = _mm_set1_ps(y);
+		glm_vec4 r = _mm_set1_ps(radius);
+		for (int i = 0; i < VertexExpand::CIRCLE_SEGMENTS; i += 4) {
+			glm_vec4 xs = glm_vec4_fma(r, _mm_loadu_ps(table.sin + i), cx);
+			glm_vec4 ys = glm_vec4_fma(r, _mm_loadu_ps(table.cos + i), cy);
+			storeQuad(out, xs, ys, zrgb, color);
+			out += 28;
+		}
+	}
+#endif
+}
+
+int VertexExpand::rects(Renderer2D::Vertex* vertices, const Renderer2D::Rect* rects, float depth, int count, const float* bounds) {
+	int written = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	float* out = vertices[0].pos;
+	glm_vec4 z = _mm_set1_ps(depth);
+	glm_vec4 viewMin, viewMax;
+	cullBounds(bounds, viewMin, viewMax);
+	for (int i = 0; i < count; ++i) {
+		// (x, y, width, height) + (0, 0, x, y) = (left, bottom, right, top)
+		glm_vec4 rect = _mm_loadu_ps(&rects[i].x);
+		glm_vec4 box = glm_vec4_add(rect, _mm_movelh_ps(_mm_setzero_ps(), rect));
+		if (!overlaps(box, viewMin, viewMax)) {
+			continue;
+		}
+		glm_vec4 color = _mm_loadu_ps(rects[i].color);
+		storeRect(out, box, depthColor(z, color), color);
+		out += 28;
+		written++;
+	}
+#else
+	for (int i = 0; i < count; ++i) {
+		const Renderer2D::Rect& rect = rects[i];
+		if (!overlaps(bounds, rect.x, rect.y, rect.x + rect.width, rect.y + rect.height)) {
+			continue;
+		}
+		Renderer2D::Vertex* v = vertices + written * 4;
+		storeVertex(v[0], rect.x, rect.y + rect.height, depth, rect.color);
+		storeVertex(v[1], rect.x + rect.width, rect.y + rect.height, depth, rect.color);
+		storeVertex(v[2], rect.x + rect.width, rect.y, depth, rect.color);
+		storeVertex(v[3], rect.x, rect.y, depth, rect.color);
+		written++;
+	}
+#endif
+	return written;
+}
+
+int VertexExpand::rects(Renderer2D::Vertex* vertices, const float* x, const float* y, const float* width, const float* height,
+	const float* colors, int colorStride, float depth, int count, const float* bounds) {
+	int i = 0;
+	int written = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	float* out = vertices[0].pos;
+	glm_vec4 z = _mm_set1_ps(depth);
+	glm_vec4 color = _mm_loadu_ps(colors);
+	glm_vec4 zrgb = depthColor(z, color);
+	glm_vec4 viewMin, viewMax;
+	cullBounds(bounds, viewMin, viewMax);
+
+	// 4 rectangles at a time, transposed into one (left, bottom, right, top) row each
+	for (; i + 4 <= count; i += 4) {
+		glm_vec4 left = _mm_loadu_ps(x + i);
+		glm_vec4 bottom = _mm_loadu_ps(y + i);
+		glm_vec4 right = glm_vec4_add(left, _mm_loadu_ps(width + i));
+		glm_vec4 top = glm_vec4_add(bottom, _mm_loadu_ps(height + i));
+		_MM_TRANSPOSE4_PS(left, bottom, right, top);
+
+		glm_vec4 rows[4] = { left, bottom, right, top };
+		for (int j = 0; j < 4; ++j) {
+			if (!overlaps(rows[j], viewMin, viewMax)) {
+				continue;
+			}
+			if (colorStride != 0) {
+				color = _mm_loadu_ps(colors + (i + j) * colorStride);
+				zrgb = depthColor(z, color);
+			}
+			storeRect(out, rows[j], zrgb, color);
+			out += 28;
+			written++;
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		if (!overlaps(bounds, x[i], y[i], x[i] + width[i], y[i] + height[i])) {
+			continue;
+		}
+		const float* color = colors + i * colorStride;
+		Renderer2D::Vertex* v = vertices + written * 4;
+		storeVertex(v[0], x[i], y[i] + height[i], depth, color);
+		storeVertex(v[1], x[i] + width[i], y[i] + height[i], depth, color);
+		storeVertex(v[2], x[i] + width[i], y[i], depth, color);
+		storeVertex(v[3], x[i], y[i], depth, color);
+		written++;
+	}
+	return written;
+}
+
+void VertexExpand::rectIndices(unsigned int* indices, unsigned int firstVertex, int count) {
+	int i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// two rectangles share 12 indices, 3 vectors
+	__m128i pattern0 = _mm_setr_epi32(0, 1, 2, 0);
+	__m128i pattern1 = _mm_setr_epi32(2, 3, 4, 5);
+	__m128i pattern2 = _mm_setr_epi32(6, 4, 6, 7);
+	__m128i base = _mm_set1_epi32((int)firstVertex);
+	__m128i step = _mm_set1_epi32(8);
+	for (; i + 2 <= count; i += 2) {
+		_mm_storeu_si128((__m128i*)(indices + 0), _mm_add_epi32(base, pattern0));
+		_mm_storeu_si128((__m128i*)(indices + 4), _mm_add_epi32(base, pattern1));
+		_mm_storeu_si128((__m128i*)(indices + 8), _mm_add_epi32(base, pattern2));
+		base = _mm_add_epi32(base, step);
+		indices += 12;
+	}
+	firstVertex += i * 4;
+#endif
+	for (; i < count; ++i) {
+		indices[0] = firstVertex + 0;
+		indices[1] = firstVertex + 1;
+		indices[2] = firstVertex + 2;
+		indices[3] = firstVertex + 0;
+		indices[4] = firstVertex + 2;
+		indices[5] = firstVertex + 3;
+		indices += 6;
+		firstVertex += 4;
+	}
+}
+
+int VertexExpand::circles(Renderer2D::Vertex* vertices, const Renderer2D::Circle* circles, float depth, int count, const float* bounds) {
+	int written = 0;
+	for (int i = 0; i < count; ++i) {
+		const Renderer2D::Circle& circle = circles[i];
+		written += VertexExpand::circles(vertices + written * CIRCLE_VERTICES, &circle.x, &circle.y, &circle.radius,
+			circle.color, 0, depth, 1, bounds);
+	}
+	return written;
+}
+
+int VertexExpand::circles(Renderer2D::Vertex* vertices, const float* x, const float* y, const float* radius,
+	const float* colors, int colorStride, float depth, int count, const float* bounds) {
+	int written = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	float* out = vertices[0].pos;
+	glm_vec4 z = _mm_set1_ps(depth);
+	for (int i = 0; i < count; ++i) {
+		if (!overlaps(bounds, x[i] - radius[i], y[i] - radius[i], x[i] + radius[i], y[i] + radius[i])) {
+			continue;
+		}
+		storeCircle(out, x[i], y[i], radius[i], z, _mm_loadu_ps(colors + i * colorStride));
+		out += CIRCLE_VERTICES * 7;
+		written++;
+	}
+#else
+	const CircleTable& table = circleTable();
+	for (int i = 0; i < count; ++i) {
+		if (!overlaps(bounds, x[i] - radius[i], y[i] - radius[i], x[i] + radius[i], y[i] + radius[i])) {
+			continue;
+		}
+		const float* color = colors + i * colorStride;
+		Renderer2D::Vertex* v = vertices + written * CIRCLE_VERTICES;
+		storeVertex(v[0], x[i], y[i], depth, color);
+		for (int j = 0; j < CIRCLE_SEGMENTS; ++j) {
+			storeVertex(v[j + 1], table.sin[j] * radius[i] + x[i], table.cos[j] * radius[i] + y[i], depth, color);
+		}
+		written++;
+	}
+#endif
+	return written;
+}
+
+void VertexExpand::circleIndices(unsigned int* indices, unsigned int firstVertex, int count) {
+	const CircleTable& table = circleTable();
+	for (int i = 0; i < count; ++i) {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128i base = _mm_set1_epi32((int)firstVertex);
+		for (int j = 0; j < CIRCLE_INDICES; j += 4) {
+			__m128i pattern = _mm_loadu_si128((const __m128i*)(table.indices + j));
+			_mm_storeu_si128((__m128i*)(indices + j), _mm_add_epi32(base, pattern));
+		}
+#else
+		for (int j = 0; j < CIRCLE_INDICES; ++j) {
+			indices[j] = firstVertex + table.indices[j];
+		}
+#endif
+		indices += CIRCLE_INDICES;
+		firstVertex += CIRCLE_VERTICES;
+	}
+}
@@ -0,0 +1,50 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: VertexExpand.h
+*
+* Description:	Expands arrays of shapes into vertices and indices.
+*				Uses the SSE wrappers of glm/simd where the target supports them.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef VERTEXEXPAND_H_
+#define VERTEXEXPAND_H_
+
+#include "Renderer2D.h"
+
+namespace VertexExpand {
+	// points of the circle outline, matches drawCircle
+	enum { CIRCLE_SEGMENTS = 32, CIRCLE_VERTICES = CIRCLE_SEGMENTS + 1, CIRCLE_INDICES = CIRCLE_SEGMENTS * 3 };
+
+	// the expanders skip shapes outside bounds, given as min x, min y, max x, max y,
+	// or nullptr to keep every shape, and return the number of shapes written
+
+	// writes 4 vertices per rectangle, top left, top right, bottom right, bottom left
+	int rects(Renderer2D::Vertex* vertices, const Renderer2D::Rect* rects, float depth, int count, const float* bounds);
+
+	// structure of arrays variant, colors holds rgba per rectangle or a single rgba when colorStride is 0
+	int rects(Renderer2D::Vertex* vertices, const float* x, const float* y, const float* width, const float* height,
+		const float* colors, int colorStride, float depth, int count, const float* bounds);
+
+	// writes 6 indices per rectangle
+	void rectIndices(unsigned int* indices, unsigned int firstVertex, int count);
+
+	// writes the center and CIRCLE_SEGMENTS outline vertices per circle
+	int circles(Renderer2D::Vertex* vertices, const Renderer2D::Circle* circles, float depth, int count, const float* bounds);
+
+	// structure of arrays variant, colors as for rects
+	int circles(Renderer2D::Vertex* vertices, const float* x, const float* y, const float* radius,
+		const float* colors, int colorStride, float depth, int count, const float* bounds);
+
+	// writes CIRCLE_INDICES indices per circle
+	void circleIndices(unsigned int* indices, unsigned int firstVertex, int count);
+}
+
+#endif // !VERTEXEXPAND_H_
@@ -166,41 +166,62 @@ static const char *exts = NULL;
 static int num_exts_i = 0;
 static char **exts_i = NULL;
 
-static int get_exts(void) {
-#ifdef _GLAD_IS_SOME_NEW_VERSION
-    if(max_loaded_major < 3) {
-#endif
-        exts = (const char *)glGetString(GL_EXTENSIONS);
-#ifdef _GLAD_IS_SOME_NEW_VERSION
-    } else {
-        unsigned int index;
+/* Every extension name is entered once into an open addressing hash set, so
+ * has_ext is a single probe instead of a scan over all extension strings. The
+ * entries point into exts_i or into the GL_EXTENSIONS string of old contexts. */
+struct glad_ext_entry {
+    const char *name;
+    size_t length;
+};
 
-        num_exts_i = 0;
-        glGetIntegerv(GL_NUM_EXTENSIONS, &num_exts_i);
-        if (num_exts_i > 0) {
-            char **tmp_exts_i = (char **)realloc((void *)exts_i, (size_t)num_exts_i * (sizeof *exts_i));
-            if (tmp_exts_i == NULL) {
-                return 0;
-            }
-            exts_i = tmp_exts_i;
-        }
+static struct glad_ext_entry *exts_hash = NULL;
+static size_t exts_hash_mask = 0;
 
-        if (exts_i == NULL) {
-            return 0;
+static size_t hash_ext(const char *ext, size_t length) {
+    /* FNV-1a */
+    size_t index;
+    unsigned int hash = 2166136261u;
+    for(index = 0; index < length; index++) {
+        hash ^= (unsigned char)ext[index];
+        hash *= 16777619u;
+    }
+    return (size_t)hash;
+}
+
+static struct glad_ext_entry *find_ext(const char *ext, size_t length) {
+    size_t slot;
+    if(exts_hash == NULL) return NULL;
+    slot = hash_ext(ext, length) & exts_hash_mask;
+    while(exts_hash[slot].name != NULL) {
+        if(exts_hash[slot].length == length && memcmp(exts_hash[slot].name, ext, length) == 0) {
+            return &exts_hash[slot];
         }
+        slot = (slot + 1) & exts_hash_mask;
+    }
+    return &exts_hash[slot];
+}
 
-        for(index = 0; index < (unsigned)num_exts_i; index++) {
-            const char *gl_str_tmp = (const char*)glGetStringi(GL_EXTENSIONS, index);
-            size_t len = strlen(gl_str_tmp);
+static void insert_ext(const char *ext, size_t length) {
+    struct glad_ext_entry *entry;
+    if(ext == NULL || length == 0) return;
+    entry = find_ext(ext, length);
+    if(entry != NULL && entry->name == NULL) {
+        entry->name = ext;
+        entry->length = length;
+    }
+}
 
-            char *local_str = (char*)malloc((len+1) * sizeof(char));
-            if(local_str != NULL) {
-                memcpy(local_str, gl_str_tmp, (len+1) * sizeof(char));
-            }
-            exts_i[index] = local_str;
-        }
+static int build_exts_hash(size_t count) {
+    /* at most half full, so probe chains stay short */
+    size_t capacity = 16;
+    while(capacity < count * 2) {
+        capacity *= 2;
     }
-#endif
+    exts_hash = (struct glad_ext_entry *)calloc(capacity, sizeof *exts_hash);
+    if(exts_hash == NULL) {
+        return 0;
+    }
+    exts_hash_mask = capacity - 1;
     return 1;
 }
 
@@ -213,48 +234,90 @@ static void free_exts(void) {
         free((void *)exts_i);
         exts_i = NULL;
     }
+    num_exts_i = 0;
+    free((void *)exts_hash);
+    exts_hash = NULL;
+    exts_hash_mask = 0;
+    exts = NULL;
 }
 
-static int has_ext(const char *ext) {
+static int get_exts(void) {
+    /* a previous load may have left its set behind */
+    free_exts();
 #ifdef _GLAD_IS_SOME_NEW_VERSION
     if(max_loaded_major < 3) {
 #endif
-        const char *extensions;
-        const char *loc;
-        const char *terminator;
-        extensions = exts;
-        if(extensions == NULL || ext == NULL) {
+        const char *begin;
+        const char *end;
+        size_t count = 0;
+
+        exts = (const char *)glGetString(GL_EXTENSIONS);
+        if(exts == NULL) {
+            return build_exts_hash(0);
+        }
+        for(begin = exts; *begin != '\0'; begin++) {
+            if(*begin != ' ' && (begin == exts || *(begin - 1) == ' ')) {
+                count++;
+            }
+        }
+        if(!build_exts_hash(count)) {
             return 0;
         }
-
-        while(1) {
-            loc = strstr(extensions, ext);
-            if(loc == NULL) {
-                return 0;
+        for(begin = exts; *begin != '\0'; begin = end) {
+            while(*begin == ' ') {
+                begin++;
             }
-
-            terminator = loc + strlen(ext);
-            if((loc == extensions || *(loc - 1) == ' ') &&
-                (*terminator == ' ' || *terminator == '\0')) {
-                return 1;
+            end = begin;
+            while(*end != ' ' && *end != '\0') {
+                end++;
             }
-            extensions = terminator;
+            insert_ext(begin, (size_t)(end - begin));
         }
 #ifdef _GLAD_IS_SOME_NEW_VERSION
     } else {
-        int index;
-        if(exts_i == NULL) return 0;
-        for(index = 0; index < num_exts_i; index++) {
-            const char *e = exts_i[index];
+        unsigned int index;
+
+        num_exts_i = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &num_exts_i);
+        if (num_exts_i > 0) {
+            exts_i = (char **)calloc((size_t)num_exts_i, sizeof *exts_i);
+        }
+
+        if (exts_i == NULL) {
+            num_exts_i = 0;
+            return 0;
+        }
+        if(!build_exts_hash((size_t)num_exts_i)) {
+            return 0;
+        }
+
+        for(index = 0; index < (unsigned)num_exts_i; index++) {
+            const char *gl_str_tmp = (const char*)glGetStringi(GL_EXTENSIONS, index);
+            size_t len = (gl_str_tmp != NULL ? strlen(gl_str_tmp) : 0);
 
-            if(exts_i[index] != NULL && strcmp(e, ext) == 0) {
-                return 1;
+            char *local_str = (char*)malloc((len+1) * sizeof(char));
+            if(local_str != NULL) {
+                memcpy(local_str, gl_str_tmp != NULL ? gl_str_tmp : "", (len+1) * sizeof(char));
+                insert_ext(local_str, len);
             }
+            exts_i[index] = local_str;
         }
     }
 #endif
+    return 1;
+}
 
-    return 0;
+static int has_ext(const char *ext) {
+    const struct glad_ext_entry *entry;
+    if(ext == NULL) {
+        return 0;
+    }
+    entry = find_ext(ext, strlen(ext));
+    return entry != NULL && entry->name != NULL;
+}
+
+int gladHasExtension(const char *ext) {
+    return has_ext(ext);
 }
 int GLAD_GL_VERSION_1_0 = 0;
 int GLAD_GL_VERSION_1_1 = 0;
@@ -1735,9 +1798,8 @@ static void load_GL_VERSION_4_6(GLADloadproc load) {
 	glad_glPolygonOffsetClamp = (PFNGLPOLYGONOFFSETCLAMPPROC)load("glPolygonOffsetClamp");
 }
 static int find_extensionsGL(void) {
+	/* the extension set stays around for gladHasExtension */
 	if (!get_exts()) return 0;
-	(void)&has_ext;
-	free_exts();
 	return 1;
 }
 
@@ -1803,32 +1865,83 @@ static void find_coreGL(void) {
 }
 
 int gladLoadGLLoader(GLADloadproc load) {
+	return gladLoadGLLoaderVersion(load, 4, 6);
+}
+
+/* Core versions in load order, with the flag that says whether their entry points
+ * are loaded. Versions above the one asked for at load time keep a 0 flag until
+ * gladRequireGLVersion resolves them through the stored loader. */
+struct glad_core_version {
+	int major, minor;
+	int *loaded;
+	void (*load)(GLADloadproc);
+};
+
+static const struct glad_core_version glad_core_versions[] = {
+	{ 1, 0, &GLAD_GL_VERSION_1_0, load_GL_VERSION_1_0 },
+	{ 1, 1, &GLAD_GL_VERSION_1_1, load_GL_VERSION_1_1 },
+	{ 1, 2, &GLAD_GL_VERSION_1_2, load_GL_VERSION_1_2 },
+	{ 1, 3, &GLAD_GL_VERSION_1_3, load_GL_VERSION_1_3 },
+	{ 1, 4, &GLAD_GL_VERSION_1_4, load_GL_VERSION_1_4 },
+	{ 1, 5, &GLAD_GL_VERSION_1_5, load_GL_VERSION_1_5 },
+	{ 2, 0, &GLAD_GL_VERSION_2_0, load_GL_VERSION_2_0 },
+	{ 2, 1, &GLAD_GL_VERSION_2_1, load_GL_VERSION_2_1 },
+	{ 3, 0, &GLAD_GL_VERSION_3_0, load_GL_VERSION_3_0 },
+	{ 3, 1, &GLAD_GL_VERSION_3_1, load_GL_VERSION_3_1 },
+	{ 3, 2, &GLAD_GL_VERSION_3_2, load_GL_VERSION_3_2 },
+	{ 3, 3, &GLAD_GL_VERSION_3_3, load_GL_VERSION_3_3 },
+	{ 4, 0, &GLAD_GL_VERSION_4_0, load_GL_VERSION_4_0 },
+	{ 4, 1, &GLAD_GL_VERSION_4_1, load_GL_VERSION_4_1 },
+	{ 4, 2, &GLAD_GL_VERSION_4_2, load_GL_VERSION_4_2 },
+	{ 4, 3, &GLAD_GL_VERSION_4_3, load_GL_VERSION_4_3 },
+	{ 4, 4, &GLAD_GL_VERSION_4_4, load_GL_VERSION_4_4 },
+	{ 4, 5, &GLAD_GL_VERSION_4_5, load_GL_VERSION_4_5 },
+	{ 4, 6, &GLAD_GL_VERSION_4_6, load_GL_VERSION_4_6 }
+};
+
+static GLADloadproc glad_loader = NULL;
+
+static int context_has_version(int major, int minor) {
+	return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+}
+
+/* loads every core version up to major.minor that the context supports and is not loaded yet */
+static void load_core_versions(int major, int minor) {
+	size_t index;
+	if(glad_loader == NULL) return;
+	for(index = 0; index < sizeof(glad_core_versions) / sizeof(glad_core_versions[0]); index++) {
+		const struct glad_core_version *version = &glad_core_versions[index];
+		if(version->major > major || (version->major == major && version->minor > minor)) break;
+		if(*version->loaded || !context_has_version(version->major, version->minor)) continue;
+		*version->loaded = 1;
+		version->load(glad_loader);
+	}
+}
+
+int gladLoadGLLoaderVersion(GLADloadproc load, int major, int minor) {
+	size_t index;
 	GLVersion.major = 0; GLVersion.minor = 0;
 	glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
 	if(glGetString == NULL) return 0;
 	if(glGetString(GL_VERSION) == NULL) return 0;
 	find_coreGL();
-	load_GL_VERSION_1_0(load);
-	load_GL_VERSION_1_1(load);
-	load_GL_VERSION_1_2(load);
-	load_GL_VERSION_1_3(load);
-	load_GL_VERSION_1_4(load);
-	load_GL_VERSION_1_5(load);
-	load_GL_VERSION_2_0(load);
-	load_GL_VERSION_2_1(load);
-	load_GL_VERSION_3_0(load);
-	load_GL_VERSION_3_1(load);
-	load_GL_VERSION_3_2(load);
-	load_GL_VERSION_3_3(load);
-	load_GL_VERSION_4_0(load);
-	load_GL_VERSION_4_1(load);
-	load_GL_VERSION_4_2(load);
-	load_GL_VERSION_4_3(load);
-	load_GL_VERSION_4_4(load);
-	load_GL_VERSION_4_5(load);
-	load_GL_VERSION_4_6(load);
+	glad_loader = load;
+
+	/* the extension list of a 3.0+ context needs glGetStringi */
+	if(major < 3) {
+		major = 3;
+		minor = 0;
+	}
+	for(index = 0; index < sizeof(glad_core_versions) / sizeof(glad_core_versions[0]); index++) {
+		*glad_core_versions[index].loaded = 0;
+	}
+	load_core_versions(major, minor);
 
 	if (!find_extensionsGL()) return 0;
 	return GLVersion.major != 0 || GLVersion.minor != 0;
 }
 
+int gladRequireGLVersion(int major, int minor) {
+	load_core_versions(major, minor);
+	return context_has_version(major, minor);
+}
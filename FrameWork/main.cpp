@@ -1,11 +1,14 @@
 #include <cstdlib>
+#ifdef _MSC_VER
 #include <crtdbg.h>
-#include "Application2D.h"
-#include "Renderer2D.h"
+#endif
+#include "Demo2D.h"
 int main()
 {
+#ifdef _MSC_VER
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
-	Application2D* app = new Application2D();
+#endif
+	Application2D* app = new Demo2D();
 	app->runApp("OpenGL", 800, 600, false);
 	delete app;
 	return 0;
@@ -92,6 +92,17 @@ GLAPI int gladLoadGL(void);
 
 GLAPI int gladLoadGLLoader(GLADloadproc);
 
+/* Loads only the core versions up to major.minor (at least 3.0) that the context supports.
+ * The GLAD_GL_VERSION_x_y flags of the versions above stay 0 until gladRequireGLVersion. */
+GLAPI int gladLoadGLLoaderVersion(GLADloadproc, int major, int minor);
+
+/* Loads the core versions up to major.minor that are not loaded yet, with the loader of the
+ * last gladLoadGLLoaderVersion call. Returns whether the context supports major.minor. */
+GLAPI int gladRequireGLVersion(int major, int minor);
+
+/* Whether the context exposes the extension, a hash lookup in the set built at load time. */
+GLAPI int gladHasExtension(const char *ext);
+
 #include <stddef.h>
 #include <KHR/khrplatform.h>
 #ifndef GLEXT_64_TYPES_DEFINED
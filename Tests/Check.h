@@ -0,0 +1,49 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: Check.h
+*
+* Description:	Minimal checks for the test executables, a failed check prints where it
+*				failed and the executable returns non-zero for CTest.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <cmath>
+#include <iostream>
+
+namespace Check {
+	inline int& failures() {
+		static int count = 0;
+		return count;
+	}
+
+	inline void check(bool passed, const char* expression, const char* file, int line) {
+		if (!passed) {
+			std::cout << file << ":" << line << ": CHECK(" << expression << ") failed" << std::endl;
+			++failures();
+		}
+	}
+
+	// @return the exit code of the test, 0 if every check passed
+	inline int result() {
+		if (failures() > 0) {
+			std::cout << failures() << " checks failed" << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+}
+
+#define CHECK(expression) Check::check((expression), #expression, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, tolerance) Check::check(std::fabs((a) - (b)) <= (tolerance), #a " == " #b, __FILE__, __LINE__)
+
+#endif // !CHECK_H_
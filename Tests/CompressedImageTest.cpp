@@ -0,0 +1,277 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: CompressedImageTest.cpp
+*
+* Description:	Checks KTX and KTX2 parsing, the BC1, BC3, ETC2 and EAC block decoders
+*				and the row flips.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "CompressedImage.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/**
+* Appends a little endian 32-bit value
+*/
+static void put32(std::vector<unsigned char>& data, unsigned int value) {
+	for (int i = 0; i < 4; ++i) {
+		data.push_back((value >> (8 * i)) & 0xFF);
+	}
+}
+
+/**
+* Appends a little endian 64-bit value
+*/
+static void put64(std::vector<unsigned char>& data, unsigned long long value) {
+	put32(data, (unsigned int)value);
+	put32(data, (unsigned int)(value >> 32));
+}
+
+/**
+* True if pixel i of an RGBA8 image has the color given
+*/
+static bool isPixel(const unsigned char* rgba, int i, int r, int g, int b, int a) {
+	return rgba[i * 4] == r && rgba[i * 4 + 1] == g && rgba[i * 4 + 2] == b && rgba[i * 4 + 3] == a;
+}
+
+/**
+* Decodes single blocks of each format with known colors
+*/
+static void testBlocks() {
+	unsigned char rgba[16 * 4];
+
+	// BC1 red and blue endpoints, pixels 0 to 3 use indices 0 to 3
+	const unsigned char bc1[8] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0, 0, 0 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_BC1, bc1, 4, 4, rgba));
+	CHECK(isPixel(rgba, 0, 255, 0, 0, 255));
+	CHECK(isPixel(rgba, 1, 0, 0, 255, 255));
+	CHECK(isPixel(rgba, 2, 170, 0, 85, 255));
+	CHECK(isPixel(rgba, 3, 85, 0, 170, 255));
+
+	// BC1 with color0 <= color1 has a midpoint and a transparent index
+	const unsigned char bc1Alpha[8] = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0, 0, 0 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_BC1_ALPHA, bc1Alpha, 4, 4, rgba));
+	CHECK(isPixel(rgba, 2, 127, 0, 127, 255));
+	CHECK(isPixel(rgba, 3, 0, 0, 0, 0));
+
+	// BC3 alpha endpoints 255 and 0, pixel 2 interpolates 1/7 of the way
+	const unsigned char bc3[16] = { 255, 0, 0x88, 0, 0, 0, 0, 0, 0x00, 0xF8, 0x1F, 0x00, 0, 0, 0, 0 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_BC3, bc3, 4, 4, rgba));
+	CHECK(isPixel(rgba, 0, 255, 0, 0, 255));
+	CHECK(isPixel(rgba, 1, 255, 0, 0, 0));
+	CHECK(isPixel(rgba, 2, 255, 0, 0, 218));
+
+	// ETC1 individual mode, the left subblock is red and the right one black
+	const unsigned char individual[8] = { 0xF0, 0, 0, 0x00, 0, 0, 0, 0 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_ETC2_RGB, individual, 4, 4, rgba));
+	CHECK(isPixel(rgba, 0, 255, 2, 2, 255));
+	CHECK(isPixel(rgba, 2, 2, 2, 2, 255));
+
+	// differential mode, flipped subblocks with table 7
+	const unsigned char differential[8] = { (16 << 3) | 7, 16 << 3, 16 << 3, (7 << 5) | (7 << 2) | 3, 0, 1, 0, 1 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_ETC2_RGB, differential, 4, 4, rgba));
+	CHECK(isPixel(rgba, 0, 0, 0, 0, 255));
+	CHECK(isPixel(rgba, 1, 179, 179, 179, 255));
+	CHECK(isPixel(rgba, 8, 170, 179, 179, 255));
+
+	// ETC2 planar mode, selected by the blue overflow
+	const unsigned char planar[8] = { 0x00, 0x00, 0xF9, 0x02, 0, 0, 0, 0 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_ETC2_RGB, planar, 4, 4, rgba));
+	CHECK(isPixel(rgba, 0, 0, 0, 105, 255));
+
+	// EAC alpha base 128, multiplier 2, table 13, every index 7 adds 9 * 2
+	const unsigned char eac[16] = { 128, 0x2D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0, 0, 0, 0, 0, 0, 0 };
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_ETC2_RGBA, eac, 4, 4, rgba));
+	CHECK(rgba[3] == 146 && rgba[15 * 4 + 3] == 146);
+
+	// sizes that are not a multiple of the block size only write the pixels inside
+	std::vector<unsigned char> blocks(2 * 8, 0), odd(5 * 3 * 4);
+	CHECK(CompressedImage::decode(CompressedImage::FORMAT_ETC2_RGB, blocks.data(), 5, 3, odd.data()));
+
+	CHECK(!CompressedImage::canDecode(CompressedImage::FORMAT_BC7));
+	CHECK(CompressedImage::levelSize(CompressedImage::FORMAT_BC1, 5, 3) == 16);
+	CHECK(CompressedImage::levelSize(CompressedImage::FORMAT_BC3, 1, 1) == 16);
+	CHECK(CompressedImage::levelSize(CompressedImage::FORMAT_RGBA8, 5, 3) == 60);
+}
+
+/**
+* Parses an 8x8 BC1 KTX2 file with 4 levels stored smallest first
+*/
+static void testKtx2() {
+	std::vector<unsigned char> file = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+	// VK_FORMAT_BC1_RGB_UNORM_BLOCK, type size 1, 8x8, no depth, layers or faces, 4 levels, no supercompression
+	unsigned int header[] = { 131, 1, 8, 8, 0, 0, 1, 4, 0 };
+	for (unsigned int value : header) {
+		put32(file, value);
+	}
+	// data format descriptor and key value offsets
+	for (int i = 0; i < 4; ++i) {
+		put32(file, 0);
+	}
+	put64(file, 0);
+	put64(file, 0);
+
+	const size_t sizes[] = { 32, 8, 8, 8 };
+	size_t offsets[4];
+	size_t offset = 80 + 4 * 24;
+	for (int i = 3; i >= 0; --i) {
+		offsets[i] = offset;
+		offset += sizes[i];
+	}
+	for (int i = 0; i < 4; ++i) {
+		put64(file, offsets[i]);
+		put64(file, sizes[i]);
+		put64(file, sizes[i]);
+	}
+	file.resize(offset, 0);
+
+	CHECK(CompressedImage::isKtx(file.data(), file.size()));
+	CompressedImage image;
+	CHECK(CompressedImage::parse(file.data(), file.size(), image));
+	CHECK(image.format == CompressedImage::FORMAT_BC1);
+	CHECK(image.width == 8 && image.height == 8);
+	CHECK(image.levels.size() == 4);
+	if (image.levels.size() == 4) {
+		CHECK(image.levels[0].offset == 200 && image.levels[0].size == 32);
+		CHECK(image.levels[3].offset == 176 && image.levels[3].width == 1 && image.levels[3].height == 1);
+	}
+
+	// more levels than an 8x8 image has
+	file[40] = 5;
+	CHECK(!CompressedImage::parse(file.data(), file.size(), image));
+}
+
+/**
+* Parses a 4x4 RGBA8 KTX file with 2 levels
+*/
+static void testKtx1() {
+	std::vector<unsigned char> file = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+	// endianness, GL_UNSIGNED_BYTE, type size 1, GL_RGBA, GL_RGBA8, GL_RGBA, 4x4, 1 face, 2 levels, 8 bytes of key values
+	unsigned int header[] = { 0x04030201, 0x1401, 1, 0x1908, 0x8058, 0x1908, 4, 4, 0, 0, 1, 2, 8 };
+	for (unsigned int value : header) {
+		put32(file, value);
+	}
+	put32(file, 0);
+	put32(file, 0);
+	put32(file, 64);
+	file.resize(file.size() + 64, 7);
+	put32(file, 16);
+	file.resize(file.size() + 16, 9);
+
+	CHECK(CompressedImage::isKtx(file.data(), file.size()));
+	CompressedImage image;
+	CHECK(CompressedImage::parse(file.data(), file.size(), image));
+	CHECK(image.format == CompressedImage::FORMAT_RGBA8);
+	CHECK(image.levels.size() == 2);
+	if (image.levels.size() == 2) {
+		CHECK(image.levels[0].offset == 76 && image.levels[0].size == 64);
+		CHECK(image.levels[1].offset == 144 && image.levels[1].size == 16);
+	}
+
+	// truncated level data
+	file.pop_back();
+	CHECK(!CompressedImage::parse(file.data(), file.size(), image));
+
+	const unsigned char png[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 0 };
+	CHECK(!CompressedImage::isKtx(png, sizeof(png)));
+}
+
+/**
+* Decodes a level before and after flipping it and compares the rows
+*/
+static void checkFlip(CompressedImage::Format format, int width, int height) {
+	std::vector<unsigned char> blocks(CompressedImage::levelSize(format, width, height));
+	unsigned int seed = 12345;
+	for (unsigned char& value : blocks) {
+		seed = seed * 1103515245 + 12345;
+		value = (unsigned char)(seed >> 16);
+	}
+	std::vector<unsigned char> before((size_t)width * height * 4), after(before.size());
+	CHECK(CompressedImage::decode(format, blocks.data(), width, height, before.data()));
+	CHECK(CompressedImage::flip(format, blocks.data(), width, height));
+	CHECK(CompressedImage::decode(format, blocks.data(), width, height, after.data()));
+	bool mirrored = true;
+	for (int y = 0; y < height; ++y) {
+		size_t row = (size_t)width * 4;
+		mirrored = mirrored && std::equal(before.begin() + y * row, before.begin() + (y + 1) * row,
+			after.begin() + (height - 1 - y) * row);
+	}
+	CHECK(mirrored);
+}
+
+/**
+* Flips levels of every format that can be flipped and the cases that cannot
+*/
+static void testFlip() {
+	checkFlip(CompressedImage::FORMAT_RGBA8, 5, 3);
+	checkFlip(CompressedImage::FORMAT_BC1, 8, 12);
+	checkFlip(CompressedImage::FORMAT_BC1_ALPHA, 4, 2);
+	checkFlip(CompressedImage::FORMAT_BC3, 12, 8);
+	checkFlip(CompressedImage::FORMAT_BC3, 8, 3);
+
+	// rows would have to move between blocks
+	CHECK(!CompressedImage::canFlip(CompressedImage::FORMAT_BC1, 6));
+	CHECK(!CompressedImage::canFlip(CompressedImage::FORMAT_ETC2_RGB, 4));
+	CHECK(!CompressedImage::canFlip(CompressedImage::FORMAT_BC7, 4));
+	unsigned char etc[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	CHECK(!CompressedImage::flip(CompressedImage::FORMAT_ETC2_RGB, etc, 4, 4));
+	CHECK(etc[0] == 1 && etc[7] == 8);
+}
+
+/**
+* Builds a 4x4 BC1 KTX2 file with a KTXorientation value and parses it
+*/
+static bool parseOrientation(const char* value, CompressedImage& image) {
+	std::vector<unsigned char> file = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+	unsigned int header[] = { 131, 1, 4, 4, 0, 0, 1, 1, 0 };
+	for (unsigned int field : header) {
+		put32(file, field);
+	}
+
+	// one key value pair after the level index, padded to 4 bytes
+	std::string pair = std::string("KTXorientation") + '\0' + value + '\0';
+	size_t pairBytes = 4 + ((pair.size() + 3) & ~(size_t)3);
+	put32(file, 0);
+	put32(file, 0);
+	put32(file, 80 + 24);
+	put32(file, (unsigned int)pairBytes);
+	put64(file, 0);
+	put64(file, 0);
+	put64(file, 80 + 24 + pairBytes);
+	put64(file, 8);
+	put64(file, 8);
+	put32(file, (unsigned int)pair.size());
+	file.insert(file.end(), pair.begin(), pair.end());
+	file.resize(80 + 24 + pairBytes + 8, 0);
+	return CompressedImage::parse(file.data(), file.size(), image);
+}
+
+/**
+* Top first for down and bottom first for up, in the KTX2 and the KTX spelling
+*/
+static void testOrientation() {
+	CompressedImage image;
+	CHECK(parseOrientation("rd", image) && image.topFirst);
+	CHECK(parseOrientation("ru", image) && !image.topFirst);
+	CHECK(parseOrientation("S=r,T=u", image) && !image.topFirst);
+}
+
+int main() {
+	testBlocks();
+	testKtx2();
+	testKtx1();
+	testFlip();
+	testOrientation();
+	return Check::result();
+}
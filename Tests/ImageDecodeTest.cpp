@@ -0,0 +1,69 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: ImageDecodeTest.cpp
+*
+* Description:	Checks the built in TGA and PPM decoders return RGBA8 rows bottom first.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "TextureLoader.h"
+
+#include <vector>
+
+/**
+* True if pixel i of an RGBA8 image has the color given
+*/
+static bool isPixel(const std::vector<unsigned char>& rgba, int i, int r, int g, int b, int a) {
+	return rgba.size() >= (size_t)(i + 1) * 4 &&
+		rgba[i * 4] == r && rgba[i * 4 + 1] == g && rgba[i * 4 + 2] == b && rgba[i * 4 + 3] == a;
+}
+
+int main() {
+	int width, height;
+	std::vector<unsigned char> rgba;
+
+	// binary PPM with a comment, the top row is red green blue and the bottom row white black gray
+	const char ppmHeader[] = "P6\n# comment\n3 2\n255\n";
+	std::vector<unsigned char> ppm(ppmHeader, ppmHeader + sizeof(ppmHeader) - 1);
+	const unsigned char ppmPixels[] = { 255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 128, 128, 128 };
+	ppm.insert(ppm.end(), ppmPixels, ppmPixels + sizeof(ppmPixels));
+	CHECK(TextureLoader::decodeBuiltin(nullptr, ppm.data(), ppm.size(), width, height, rgba));
+	CHECK(width == 3 && height == 2);
+	CHECK(isPixel(rgba, 0, 255, 255, 255, 255));
+	CHECK(isPixel(rgba, 2, 128, 128, 128, 255));
+	CHECK(isPixel(rgba, 3, 255, 0, 0, 255));
+	CHECK(isPixel(rgba, 5, 0, 0, 255, 255));
+
+	// run length encoded 24-bit TGA, 4x2 with the origin at the top left,
+	// pixels are stored BGR: a run of 4 blue, then one raw green and a run of 3 of (3, 2, 1)
+	unsigned char tgaHeader[18] = { 0, 0, 10 };
+	tgaHeader[12] = 4;
+	tgaHeader[14] = 2;
+	tgaHeader[16] = 24;
+	tgaHeader[17] = 0x20;
+	std::vector<unsigned char> tga(tgaHeader, tgaHeader + sizeof(tgaHeader));
+	const unsigned char tgaPixels[] = { 0x83, 255, 0, 0, 0x00, 0, 255, 0, 0x82, 1, 2, 3 };
+	tga.insert(tga.end(), tgaPixels, tgaPixels + sizeof(tgaPixels));
+	CHECK(TextureLoader::decodeBuiltin(nullptr, tga.data(), tga.size(), width, height, rgba));
+	CHECK(width == 4 && height == 2);
+	CHECK(isPixel(rgba, 0, 0, 255, 0, 255));
+	CHECK(isPixel(rgba, 1, 3, 2, 1, 255));
+	CHECK(isPixel(rgba, 4, 0, 0, 255, 255));
+	CHECK(isPixel(rgba, 7, 0, 0, 255, 255));
+
+	// truncated data and unknown formats fail
+	tga.pop_back();
+	CHECK(!TextureLoader::decodeBuiltin(nullptr, tga.data(), tga.size(), width, height, rgba));
+	const unsigned char text[] = "not an image";
+	CHECK(!TextureLoader::decodeBuiltin(nullptr, text, sizeof(text), width, height, rgba));
+
+	return Check::result();
+}
@@ -0,0 +1,74 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: SortKeyTest.cpp
+*
+* Description:	Checks the draw order the sort keys give and the radix sort against a stable sort.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "Renderer2D.h"
+#include "SortKey.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// the pipelines of Renderer2D, in the same order
+enum { TRIANGLES, POINTS, TEXT };
+
+int main() {
+	// opaque draws before translucent, front to back, grouped by pipeline before depth
+	unsigned long long nearOpaque = SortKey::make(TRIANGLES, 1, Renderer2D::BLEND_OPAQUE, 0, 10, 5);
+	unsigned long long farOpaque = SortKey::make(TRIANGLES, 1, Renderer2D::BLEND_OPAQUE, 0, 20, 0);
+	unsigned long long alpha = SortKey::make(TRIANGLES, 1, Renderer2D::BLEND_ALPHA, 255, 0, 0);
+	CHECK(nearOpaque < farOpaque);
+	CHECK(farOpaque < alpha);
+	CHECK(SortKey::make(TRIANGLES, 1, Renderer2D::BLEND_OPAQUE, 0, 900, 0) < SortKey::make(POINTS, 0, Renderer2D::BLEND_OPAQUE, 0, 0, 0));
+
+	// translucent draws back to front by layer, a higher layer is drawn on top
+	CHECK(SortKey::make(TEXT, 3, Renderer2D::BLEND_ALPHA, 1, 0, 0) < SortKey::make(TRIANGLES, 0, Renderer2D::BLEND_ADDITIVE, 2, 0, 0));
+	CHECK(SortKey::make(TRIANGLES, 0, Renderer2D::BLEND_ADDITIVE, 1, 0, 9) < SortKey::make(TRIANGLES, 0, Renderer2D::BLEND_ALPHA, 2, 0, 0));
+
+	// alpha blending keeps submission order whatever the pipeline and texture
+	CHECK(SortKey::make(TEXT, 7, Renderer2D::BLEND_ALPHA, 4, 0, 1) < SortKey::make(TRIANGLES, 0, Renderer2D::BLEND_ALPHA, 4, 0, 2));
+	CHECK(SortKey::make(TRIANGLES, 9, Renderer2D::BLEND_ALPHA, 4, 0, 3) < SortKey::make(POINTS, 1, Renderer2D::BLEND_ALPHA, 4, 0, 4));
+
+	// additive blending commutes, so it groups by pipeline and texture instead
+	CHECK(SortKey::make(TRIANGLES, 2, Renderer2D::BLEND_ADDITIVE, 4, 0, 8) < SortKey::make(TEXT, 1, Renderer2D::BLEND_ADDITIVE, 4, 0, 1));
+	CHECK(SortKey::make(TEXT, 1, Renderer2D::BLEND_ADDITIVE, 4, 0, 8) < SortKey::make(TEXT, 2, Renderer2D::BLEND_ADDITIVE, 4, 0, 1));
+
+	// the radix sort is stable and agrees with std::stable_sort
+	std::mt19937_64 random(11);
+	for (size_t count : { 0, 1, 2, 100, 5000 }) {
+		std::vector<unsigned long long> keys(count), tmpKeys(count);
+		std::vector<unsigned int> values(count), tmpValues(count);
+		std::vector<std::pair<unsigned long long, unsigned int>> expected(count);
+		for (size_t i = 0; i < count; ++i) {
+			// few distinct keys so the order of equal keys is tested
+			keys[i] = (random() % 16) << (random() % 60);
+			values[i] = (unsigned int)i;
+			expected[i] = std::make_pair(keys[i], values[i]);
+		}
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const std::pair<unsigned long long, unsigned int>& a, const std::pair<unsigned long long, unsigned int>& b) {
+				return a.first < b.first;
+			});
+
+		SortKey::radixSort(keys.data(), values.data(), tmpKeys.data(), tmpValues.data(), count);
+		bool same = true;
+		for (size_t i = 0; i < count; ++i) {
+			same = same && keys[i] == expected[i].first && values[i] == expected[i].second;
+		}
+		CHECK(same);
+	}
+
+	return Check::result();
+}
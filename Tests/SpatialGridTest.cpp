@@ -0,0 +1,110 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: SpatialGridTest.cpp
+*
+* Description:	Checks grid queries against a brute force search while items are added, moved and removed.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+/**
+* Random value in [0, range)
+*/
+static float randomValue(float range) {
+	return std::rand() / (RAND_MAX + 1.0f) * range;
+}
+
+/**
+* Random bounds, one item in fifty is wide enough to go to the large item list
+*/
+static void randomBounds(float* bounds) {
+	bounds[0] = randomValue(20000.0f) - 10000.0f;
+	bounds[1] = randomValue(20000.0f) - 10000.0f;
+	bounds[2] = bounds[0] + (std::rand() % 50 == 0 ? randomValue(3000.0f) : randomValue(100.0f));
+	bounds[3] = bounds[1] + randomValue(100.0f);
+}
+
+int main() {
+	const int items = 2000;
+	SpatialGrid grid(128.0f);
+	std::vector<float> bounds(items * 4);
+	std::vector<bool> alive(items, false);
+
+	std::srand(7);
+	for (int step = 0; step < 20000; ++step) {
+		int id = std::rand() % items;
+		float* b = &bounds[id * 4];
+		switch (std::rand() % 3) {
+		case 0:
+			if (!alive[id]) {
+				randomBounds(b);
+				grid.insert(id, b);
+				alive[id] = true;
+			}
+			break;
+		case 1:
+			if (alive[id]) {
+				float dx = randomValue(300.0f) - 150.0f;
+				float dy = randomValue(300.0f) - 150.0f;
+				b[0] += dx;
+				b[2] += dx;
+				b[1] += dy;
+				b[3] += dy;
+				grid.move(id, b);
+			}
+			break;
+		default:
+			if (alive[id]) {
+				grid.remove(id);
+				alive[id] = false;
+			}
+			break;
+		}
+		CHECK(grid.contains(id) == alive[id]);
+
+		if (step % 250 == 0) {
+			float query[4];
+			if (step % 2000 == 0) {
+				float infinity = std::numeric_limits<float>::infinity();
+				query[0] = query[1] = -infinity;
+				query[2] = query[3] = infinity;
+			}
+			else {
+				query[0] = randomValue(20000.0f) - 10000.0f;
+				query[1] = randomValue(20000.0f) - 10000.0f;
+				query[2] = query[0] + randomValue(4000.0f);
+				query[3] = query[1] + randomValue(4000.0f);
+			}
+
+			std::vector<unsigned int> found;
+			grid.query(query, found);
+			std::sort(found.begin(), found.end());
+			CHECK(std::adjacent_find(found.begin(), found.end()) == found.end());
+
+			std::vector<unsigned int> expected;
+			for (int i = 0; i < items; ++i) {
+				const float* e = &bounds[i * 4];
+				if (alive[i] && e[2] >= query[0] && e[3] >= query[1] && e[0] <= query[2] && e[1] <= query[3]) {
+					expected.push_back(i);
+				}
+			}
+			CHECK(found == expected);
+		}
+	}
+
+	return Check::result();
+}
@@ -0,0 +1,117 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: StrokeTest.cpp
+*
+* Description:	Checks the area and the buffer bounds of stroked polylines, whole and streamed.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "Stroke.h"
+
+#include <cmath>
+
+static Renderer2D::Vertex s_vertices[4096];
+static unsigned int s_indices[16384];
+
+/**
+* Area covered by the triangles, the stroke does not overlap itself on the shapes tested here
+* @param vertices - the vertex buffer the indices point into
+* @param indices - 3 indices per triangle
+* @param indexCount - number of indices
+*/
+static double strokeArea(const Renderer2D::Vertex* vertices, const unsigned int* indices, int indexCount) {
+	double area = 0.0;
+	for (int i = 0; i + 2 < indexCount; i += 3) {
+		const float* a = vertices[indices[i]].pos;
+		const float* b = vertices[indices[i + 1]].pos;
+		const float* c = vertices[indices[i + 2]].pos;
+		area += 0.5 * ((b[0] - a[0]) * (c[1] - a[1]) - (c[0] - a[0]) * (b[1] - a[1]));
+	}
+	return std::fabs(area);
+}
+
+/**
+* Strokes a polyline in one call
+* @return the area of the stroke
+*/
+static double stroke(const float* points, int count, bool closed, const Stroke::Style& style) {
+	const float color[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	int vertexCount, indexCount;
+	Stroke::polyline(s_vertices, s_indices, 0, points, count, closed, style, 0.0f, color, vertexCount, indexCount);
+	CHECK(vertexCount <= Stroke::maxVertices(count));
+	CHECK(indexCount <= Stroke::maxIndices(count));
+	return strokeArea(s_vertices, s_indices, indexCount);
+}
+
+/**
+* Strokes a polyline through a Stroker, moving to a fresh buffer every few points
+* @return the area of all the chunks
+*/
+static double streamed(const float* points, int count, bool closed, const Stroke::Style& style) {
+	const float color[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	Stroke::Output output = { s_vertices, s_indices, 0, 0.0f, color, 0, 0 };
+	Stroke::Stroker stroker;
+	stroker.begin(style, closed);
+	stroker.setOutput(output);
+
+	double area = 0.0;
+	for (int i = 0; i < count; ++i) {
+		if (i % 3 == 2) {
+			const Stroke::Output& written = stroker.getOutput();
+			area += strokeArea(s_vertices, s_indices, written.indexCount);
+			stroker.setOutput(output);
+		}
+		stroker.addPoint(points[i * 2], points[i * 2 + 1]);
+	}
+	stroker.end();
+	const Stroke::Output& written = stroker.getOutput();
+	area += strokeArea(s_vertices, s_indices, written.indexCount);
+	return area;
+}
+
+int main() {
+	// a 10 long segment 2 wide, square caps add half the width at each end
+	const float line[] = { 0, 0, 10, 0 };
+	CHECK_NEAR(stroke(line, 2, false, { 2.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_BUTT, 1.0f }), 20.0, 1e-3);
+	CHECK_NEAR(stroke(line, 2, false, { 2.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_SQUARE, 1.0f }), 24.0, 1e-3);
+	double round = stroke(line, 2, false, { 2.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_ROUND, 1.0f });
+	CHECK(round > 22.9 && round < 20.0 + 3.14159265);
+
+	// the thin threshold is in pixels, zoomed out to a quarter pixel the caps go, zoomed in they stay
+	CHECK_NEAR(stroke(line, 2, false, { 2.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_SQUARE, 0.25f }), 20.0, 1e-3);
+	CHECK_NEAR(stroke(line, 2, false, { 0.5f, Renderer2D::JOIN_MITER, Renderer2D::CAP_SQUARE, 4.0f }), 5.25, 1e-3);
+
+	// right angle, the mitered corner is an L of 22 by 2 and 2 by 9
+	const float corner[] = { 0, 0, 10, 0, 10, 10 };
+	CHECK_NEAR(stroke(corner, 3, false, { 2.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_BUTT, 1.0f }), 40.0, 1e-3);
+	double bevel = stroke(corner, 3, false, { 2.0f, Renderer2D::JOIN_BEVEL, Renderer2D::CAP_BUTT, 1.0f });
+	CHECK(stroke(corner, 3, false, { 2.0f, Renderer2D::JOIN_ROUND, Renderer2D::CAP_BUTT, 1.0f }) > bevel);
+
+	// closed square outline with mitered corners is the outer square minus the inner one
+	const float square[] = { 0, 0, 10, 0, 10, 10, 0, 10 };
+	CHECK_NEAR(stroke(square, 4, true, { 2.0f, Renderer2D::JOIN_MITER, Renderer2D::CAP_BUTT, 1.0f }), 12.0 * 12.0 - 8.0 * 8.0, 1e-3);
+
+	// streaming through small buffers gives the same triangles as a single call
+	float zigzag[40];
+	for (int i = 0; i < 20; ++i) {
+		zigzag[i * 2] = i * 10.0f;
+		zigzag[i * 2 + 1] = (i % 2) * 10.0f + (i % 5);
+	}
+	for (int closed = 0; closed < 2; ++closed) {
+		for (int join = 0; join < 3; ++join) {
+			Stroke::Style style = { 3.0f, (Renderer2D::LineJoin)join, Renderer2D::CAP_ROUND, 1.0f };
+			double whole = stroke(zigzag, 20, closed != 0, style);
+			CHECK_NEAR(streamed(zigzag, 20, closed != 0, style), whole, whole * 1e-4);
+		}
+	}
+
+	return Check::result();
+}
@@ -0,0 +1,175 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: TriangulateTest.cpp
+*
+* Description:	Checks that ear clipping covers the area of polygons with and without holes.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "Triangulate.h"
+
+#include <cmath>
+#include <vector>
+
+/**
+* Signed area of the triangles, positive for clockwise triangles
+* @param points - x, y pairs
+* @param indices - 3 indices per triangle
+*/
+static double triangleArea(const std::vector<float>& points, const std::vector<unsigned int>& indices) {
+	double area = 0.0;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		const float* a = &points[indices[i] * 2];
+		const float* b = &points[indices[i + 1] * 2];
+		const float* c = &points[indices[i + 2] * 2];
+		area -= 0.5 * ((b[0] - a[0]) * (c[1] - a[1]) - (c[0] - a[0]) * (b[1] - a[1]));
+	}
+	return area;
+}
+
+/**
+* Area of the outline minus the area of the holes
+* @param points - x, y pairs of all rings
+* @param rings - points per ring
+*/
+static double polygonArea(const std::vector<float>& points, const std::vector<int>& rings) {
+	double area = 0.0;
+	int first = 0;
+	for (size_t r = 0; r < rings.size(); ++r) {
+		double ring = 0.0;
+		for (int i = 0; i < rings[r]; ++i) {
+			const float* a = &points[(first + i) * 2];
+			const float* b = &points[(first + (i + 1) % rings[r]) * 2];
+			ring += a[0] * b[1] - b[0] * a[1];
+		}
+		area += (r == 0 ? 0.5 : -0.5) * std::fabs(ring);
+		first += rings[r];
+	}
+	return area;
+}
+
+/**
+* Triangulates a polygon and checks the triangles are clockwise and cover its area exactly
+* @param points - x, y pairs of all rings
+* @param rings - points per ring
+*/
+static void checkCovers(const std::vector<float>& points, const std::vector<int>& rings) {
+	std::vector<unsigned int> indices;
+	CHECK(Triangulate::earClip(points.data(), rings.data(), (int)rings.size(), indices));
+	CHECK(indices.size() % 3 == 0);
+
+	double expected = polygonArea(points, rings);
+	CHECK_NEAR(triangleArea(points, indices), expected, expected * 1e-4);
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		std::vector<unsigned int> triangle(indices.begin() + i, indices.begin() + i + 3);
+		CHECK(triangleArea(points, triangle) >= 0.0);
+	}
+}
+
+/**
+* Axis aligned rectangle ring
+* @param winding - 1 for counter clockwise, -1 for clockwise
+*/
+static void addRect(std::vector<float>& points, float minX, float minY, float maxX, float maxY, int winding) {
+	float ring[] = { minX, minY, maxX, minY, maxX, maxY, minX, maxY };
+	if (winding < 0) {
+		float reversed[] = { minX, minY, minX, maxY, maxX, maxY, maxX, minY };
+		points.insert(points.end(), reversed, reversed + 8);
+	}
+	else {
+		points.insert(points.end(), ring, ring + 8);
+	}
+}
+
+int main() {
+	std::vector<float> points;
+
+	// square in both windings
+	addRect(points, 0, 0, 10, 10, 1);
+	checkCovers(points, { 4 });
+	points.clear();
+	addRect(points, 0, 0, 10, 10, -1);
+	checkCovers(points, { 4 });
+
+	// concave U
+	checkCovers({ 0, 0, 30, 0, 30, 30, 20, 30, 20, 10, 10, 10, 10, 30, 0, 30 }, { 8 });
+
+	// star
+	points.clear();
+	for (int i = 0; i < 10; ++i) {
+		float radius = i % 2 ? 4.0f : 10.0f;
+		points.push_back(radius * std::cos(i * 3.14159265f / 5.0f));
+		points.push_back(radius * std::sin(i * 3.14159265f / 5.0f));
+	}
+	checkCovers(points, { 10 });
+
+	// collinear points on the outline
+	checkCovers({ 0, 0, 5, 0, 10, 0, 10, 10, 0, 10 }, { 5 });
+
+	// one hole, and holes side by side
+	points.clear();
+	addRect(points, 0, 0, 10, 10, 1);
+	addRect(points, 3, 3, 7, 7, 1);
+	checkCovers(points, { 4, 4 });
+	points.clear();
+	addRect(points, 0, 0, 20, 10, 1);
+	addRect(points, 2, 2, 8, 8, 1);
+	addRect(points, 12, 2, 18, 8, -1);
+	checkCovers(points, { 4, 4, 4 });
+
+	// holes stacked on the same x, the second bridge ends on a vertex the first one duplicated
+	points.clear();
+	addRect(points, 0, 0, 100, 100, 1);
+	addRect(points, 40, 10, 60, 30, 1);
+	addRect(points, 40, 60, 60, 80, 1);
+	checkCovers(points, { 4, 4, 4 });
+
+	// staggered holes, the bridge of the left hole reaches a vertex of the right hole's bridge
+	points.clear();
+	addRect(points, 0, 0, 100, 100, 1);
+	addRect(points, 40, 10, 60, 30, 1);
+	addRect(points, 10, 60, 30, 80, 1);
+	checkCovers(points, { 4, 4, 4 });
+
+	// a grid of holes in both windings, every bridge after the first column lands on earlier ones
+	points.clear();
+	addRect(points, 0, 0, 100, 100, 1);
+	std::vector<int> rings = { 4 };
+	for (int i = 0; i < 9; ++i) {
+		float x = 10.0f + (i % 3) * 30.0f;
+		float y = 10.0f + (i / 3) * 30.0f;
+		addRect(points, x, y, x + 20.0f, y + 20.0f, i % 2 ? 1 : -1);
+		rings.push_back(4);
+	}
+	checkCovers(points, rings);
+
+	// disc with two round holes
+	points.clear();
+	const float pi = 3.14159265f;
+	for (int i = 0; i < 64; ++i) {
+		points.push_back(100.0f * std::cos(i * pi / 32.0f));
+		points.push_back(100.0f * std::sin(i * pi / 32.0f));
+	}
+	for (int i = 0; i < 16; ++i) {
+		points.push_back(30.0f + 20.0f * std::cos(-i * pi / 8.0f));
+		points.push_back(20.0f * std::sin(-i * pi / 8.0f));
+	}
+	for (int i = 0; i < 16; ++i) {
+		points.push_back(-30.0f + 20.0f * std::cos(i * pi / 8.0f));
+		points.push_back(20.0f * std::sin(i * pi / 8.0f));
+	}
+	checkCovers(points, { 64, 16, 16 });
+
+	// the hash tells polygons apart
+	CHECK(Triangulate::hash(points.data(), 10, nullptr, 0) != Triangulate::hash(points.data(), 9, nullptr, 0));
+
+	return Check::result();
+}
@@ -0,0 +1,137 @@
+/**
+*************************************************************************************************
+* OpenGL-Framework
+* Copyright (c) 2018 Ramkumar Thiyagarajan
+*************************************************************************************************
+* File: VertexExpandTest.cpp
+*
+* Description:	Checks the rectangle and circle expanders write the same vertices from either layout
+*				and skip the shapes outside the bounds.
+*
+* Author: Ramkumar Thiyagarajan
+*
+* Date: 10/19/2026
+*************************************************************************************************
+*/
+
+#include "Check.h"
+#include "VertexExpand.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/**
+* True if two runs of vertices hold the same positions and colors, compared as floats so 0 and -0 match
+* @param count - number of vertices
+*/
+static bool sameVertices(const Renderer2D::Vertex* a, const Renderer2D::Vertex* b, int count) {
+	for (int i = 0; i < count; ++i) {
+		for (int k = 0; k < 3; ++k) {
+			if (a[i].pos[k] != b[i].pos[k]) {
+				return false;
+			}
+		}
+		for (int k = 0; k < 4; ++k) {
+			if (a[i].color[k] != b[i].color[k]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+* True if a vertex has the position, depth and color given
+*/
+static bool isVertex(const Renderer2D::Vertex& v, float x, float y, float depth, const float* color) {
+	return v.pos[0] == x && v.pos[1] == y && v.pos[2] == depth &&
+		v.color[0] == color[0] && v.color[1] == color[1] && v.color[2] == color[2] && v.color[3] == color[3];
+}
+
+int main() {
+	// 7 rectangles so the 4 wide loops also run their remainder
+	const int count = 7;
+	std::vector<Renderer2D::Rect> rects(count);
+	std::vector<float> x(count), y(count), width(count), height(count), colors(count * 4);
+	for (int i = 0; i < count; ++i) {
+		Renderer2D::Rect& rect = rects[i];
+		rect.x = i * 10.0f;
+		rect.y = i * -5.0f;
+		rect.width = 4.0f + i;
+		rect.height = 2.0f;
+		for (int c = 0; c < 4; ++c) {
+			rect.color[c] = (i + c) / 10.0f;
+			colors[i * 4 + c] = rect.color[c];
+		}
+		x[i] = rect.x;
+		y[i] = rect.y;
+		width[i] = rect.width;
+		height[i] = rect.height;
+	}
+
+	// corners top left, top right, bottom right, bottom left
+	std::vector<Renderer2D::Vertex> aos(count * 4), soa(count * 4);
+	CHECK(VertexExpand::rects(aos.data(), rects.data(), 0.5f, count, nullptr) == count);
+	CHECK(isVertex(aos[0], 0.0f, 2.0f, 0.5f, rects[0].color));
+	CHECK(isVertex(aos[1], 4.0f, 2.0f, 0.5f, rects[0].color));
+	CHECK(isVertex(aos[2], 4.0f, 0.0f, 0.5f, rects[0].color));
+	CHECK(isVertex(aos[3], 0.0f, 0.0f, 0.5f, rects[0].color));
+	CHECK(isVertex(aos[6 * 4 + 2], 70.0f, -30.0f, 0.5f, rects[6].color));
+
+	CHECK(VertexExpand::rects(soa.data(), x.data(), y.data(), width.data(), height.data(), colors.data(), 4, 0.5f, count, nullptr) == count);
+	CHECK(sameVertices(aos.data(), soa.data(), count * 4));
+
+	// a single color with a stride of 0
+	CHECK(VertexExpand::rects(soa.data(), x.data(), y.data(), width.data(), height.data(), colors.data(), 0, 0.5f, count, nullptr) == count);
+	CHECK(isVertex(soa[6 * 4], 60.0f, -28.0f, 0.5f, rects[0].color));
+
+	// bounds touching the edge of a rectangle keep it, the others are skipped and the rest packed
+	const float bounds[] = { 14.0f, -100.0f, 40.0f, 100.0f };
+	int written = VertexExpand::rects(aos.data(), rects.data(), 0.5f, count, bounds);
+	CHECK(written == 4);
+	CHECK(isVertex(aos[0], 10.0f, -3.0f, 0.5f, rects[1].color));
+	CHECK(isVertex(aos[2 * 4], 30.0f, -13.0f, 0.5f, rects[3].color));
+	CHECK(VertexExpand::rects(soa.data(), x.data(), y.data(), width.data(), height.data(), colors.data(), 4, 0.5f, count, bounds) == written);
+	CHECK(sameVertices(aos.data(), soa.data(), written * 4));
+
+	std::vector<unsigned int> indices(VertexExpand::CIRCLE_INDICES);
+	VertexExpand::rectIndices(indices.data(), 100, 2);
+	for (int i = 0; i < 12; ++i) {
+		CHECK(indices[i] >= (i < 6 ? 100u : 104u) && indices[i] < (i < 6 ? 104u : 108u));
+	}
+
+	// circles: the center, then the outline starting straight above it
+	std::vector<Renderer2D::Circle> circles(count);
+	std::vector<float> radius(count);
+	for (int i = 0; i < count; ++i) {
+		circles[i].x = x[i];
+		circles[i].y = y[i];
+		circles[i].radius = radius[i] = 1.0f + i;
+		std::memcpy(circles[i].color, rects[i].color, sizeof(circles[i].color));
+	}
+	std::vector<Renderer2D::Vertex> circleAos(count * VertexExpand::CIRCLE_VERTICES), circleSoa(count * VertexExpand::CIRCLE_VERTICES);
+	CHECK(VertexExpand::circles(circleAos.data(), circles.data(), 0.25f, count, nullptr) == count);
+	CHECK(VertexExpand::circles(circleSoa.data(), x.data(), y.data(), radius.data(), colors.data(), 4, 0.25f, count, nullptr) == count);
+	CHECK(sameVertices(circleAos.data(), circleSoa.data(), count * VertexExpand::CIRCLE_VERTICES));
+
+	const Renderer2D::Vertex* circle = &circleAos[2 * VertexExpand::CIRCLE_VERTICES];
+	CHECK(isVertex(circle[0], 20.0f, -10.0f, 0.25f, rects[2].color));
+	CHECK_NEAR(circle[1].pos[0], 20.0f, 1e-5f);
+	CHECK_NEAR(circle[1].pos[1], -7.0f, 1e-5f);
+	for (int i = 1; i < VertexExpand::CIRCLE_VERTICES; ++i) {
+		float dx = circle[i].pos[0] - 20.0f;
+		float dy = circle[i].pos[1] + 10.0f;
+		CHECK_NEAR(std::sqrt(dx * dx + dy * dy), 3.0f, 1e-4f);
+	}
+
+	CHECK(VertexExpand::circles(circleAos.data(), circles.data(), 0.25f, count, bounds) ==
+		VertexExpand::circles(circleSoa.data(), x.data(), y.data(), radius.data(), colors.data(), 4, 0.25f, count, bounds));
+
+	VertexExpand::circleIndices(indices.data(), 0, 1);
+	for (int i = 0; i < VertexExpand::CIRCLE_INDICES; ++i) {
+		CHECK(indices[i] < (unsigned int)VertexExpand::CIRCLE_VERTICES);
+	}
+
+	return Check::result();
+}